@@ -6,7 +6,8 @@
 #define AI_ALPHA_BETA_H
 
 #include "game.h"
+#include "search.h"
 
-void ai_alpha_beta_move(const GameState *state, Move *selected_move);
+void ai_alpha_beta_move(SearchContext *ctx, const GameState *state, Move *selected_move);
 
 #endif //AI_ALPHA_BETA_H
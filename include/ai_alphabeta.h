@@ -1,5 +1,6 @@
 #ifndef AI_ALPHABETA_H
 #define AI_ALPHABETA_H
 #include "game.h"
-void ai_alphabeta_move(const GameState *state, Move *selected_move);
+#include "search.h"
+void ai_alphabeta_move(SearchContext *ctx, const GameState *state, Move *selected_move);
 #endif
@@ -1,5 +1,6 @@
 #ifndef AI_ASPIRATION_H
 #define AI_ASPIRATION_H
 #include "game.h"
-void ai_aspiration_move(const GameState *state, Move *selected_move);
+#include "search.h"
+void ai_aspiration_move(SearchContext *ctx, const GameState *state, Move *selected_move);
 #endif
@@ -2,30 +2,28 @@
 #define AI_COMMON_H
 
 #include "game.h"
+#include "search.h"
 #include <stdint.h>
 
-#define MAX_DEPTH 50
 #define WIN_SCORE 100000
 #define TIME_LIMIT_MS 2000
-#define HASH_SIZE 1048576
-
-#define TT_EXACT 0
-#define TT_LOWER 1
-#define TT_UPPER 2
-
 #define SEEDS_TO_WIN 49
 #define MAX_TURNS 400
 
-typedef struct {
-    uint64_t hash;
-    int depth;
-    int score;
-    int flag;
-    Move best_move;
-    int valid;
-} TTEntry;
-
-uint64_t compute_hash(const GameState *state);
 int base_evaluate(const GameState *state, PlayerIndex maximizing_player);
 
+// Menaces de capture (ctx->eval_threats), en points par graine : le joueur au
+// trait peut prendre sa meilleure capture tout de suite, l'autre devra attendre
+#define THREAT_MOVER_WEIGHT 60
+#define THREAT_WAITING_WEIGHT 20
+
+// base_evaluate derrière le cache d'évaluation du contexte, plus les menaces si
+// ctx->eval_threats ; stats reçoit les compteurs (ceux du thread pour PVS v2)
+int cached_evaluate(SearchContext *ctx, EvalCacheStats *stats, const GameState *state, PlayerIndex maximizing_player);
+
+// Tri des coups partagé par les recherches min/max : coup de la table,
+// killers du ply, puis nombre de graines capturées ; scores reçoit les clés de tri
+void order_moves(SearchContext *ctx, const GameState *state, Move *moves, int n,
+                 int *scores, int ply, const Move *tt_move);
+
 #endif
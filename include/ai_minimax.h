@@ -5,8 +5,9 @@
 #define AI_MINIMAX_H
 
 #include "game.h"
+#include "search.h"
 
-void ai_minimax_move(const GameState *state, Move *selected_move);
+void ai_minimax_move(SearchContext *ctx, const GameState *state, Move *selected_move);
 
 #endif // AI_MINIMAX_H
 
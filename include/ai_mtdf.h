@@ -1,5 +1,6 @@
 #ifndef AI_MTDF_H
 #define AI_MTDF_H
 #include "game.h"
-void ai_mtdf_move(const GameState *state, Move *selected_move);
+#include "search.h"
+void ai_mtdf_move(SearchContext *ctx, const GameState *state, Move *selected_move);
 #endif
@@ -1,5 +1,6 @@
 #ifndef AI_PVS_H
 #define AI_PVS_H
 #include "game.h"
-void ai_pvs_move(const GameState *state, Move *selected_move);
+#include "search.h"
+void ai_pvs_move(SearchContext *ctx, const GameState *state, Move *selected_move);
 #endif
@@ -6,7 +6,12 @@
 #define AI_ALPHA_BETA_NUL_H
 
 #include "game.h"
+#include "ai_common.h"
 
-void ai_pvs_v2_move(const GameState *state, Move *selected_move);
+#define PVS_V2_MAX_THREADS 64
+
+// Lazy SMP : ctx->num_threads threads cherchent en parallèle ; les statistiques
+// (dont le temps pour atteindre chaque profondeur) sont dans ctx->stats
+void ai_pvs_v2_move(SearchContext *ctx, const GameState *state, Move *selected_move);
 
 #endif //AI_ALPHA_BETA_NUL_H
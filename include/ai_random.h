@@ -6,7 +6,8 @@
 #define AI_RANDOM_H
 
 #include "game.h"
+#include "search.h"
 
-void ai_random_move(const GameState *state, Move *selected_move);
+void ai_random_move(SearchContext *ctx, const GameState *state, Move *selected_move);
 
 #endif //AI_RANDOM_H
@@ -0,0 +1,54 @@
+//
+// book.h - Livre d'ouvertures : positions du début de partie cherchées hors ligne
+//
+// Fichier binaire : un en-tête puis les entrées triées par clé Zobrist. Le
+// joueur le projette en mémoire (mmap) et y cherche par dichotomie, sans
+// allocation ni lecture au moment de jouer.
+//
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BOOK_MAGIC "AWLEBK01"
+#define BOOK_DEFAULT_PATH "book.bin"
+
+typedef struct {
+    char magic[8];
+    uint64_t count;
+} BookHeader;
+
+// 16 octets, triées par key
+typedef struct {
+    uint64_t key;         // state->hash de la position, trait compris
+    int32_t score;        // Score de la recherche, du point de vue du joueur au trait
+    uint8_t move;         // Meilleur coup (pack_move)
+    uint8_t depth;        // Profondeur complète atteinte
+    uint16_t reserved;
+} BookEntry;
+
+typedef struct {
+    const BookEntry *entries;
+    size_t count;
+    void *data;           // Zone projetée (map_file)
+    size_t size;
+} Book;
+
+// Projette le livre en mémoire ; false si absent ou invalide (book reste vide)
+bool book_open(Book *book, const char *path);
+void book_close(Book *book);
+
+// Entrée de la position, par dichotomie
+bool book_probe(const Book *book, uint64_t key, BookEntry *out);
+
+// Coup du livre pour state, s'il existe et est légal
+bool book_move(const Book *book, const GameState *state, Move *move);
+
+// Trie les entrées, garde la plus profonde par clé et écrit le livre de façon
+// atomique (fichier temporaire puis rename). Renvoie false en cas d'erreur
+bool book_write(const char *path, BookEntry *entries, size_t count);
+
+#endif // BOOK_H
@@ -0,0 +1,44 @@
+//
+// evalcache.h - Cache d'évaluation : score statique des positions déjà évaluées
+//
+// Table à accès direct, une entrée de 8 octets par position (8 par ligne de
+// cache) : les 48 bits hauts de la clé servent de contrôle, les 16 bits bas
+// portent le score. Une entrée s'écrit en un seul mot atomique, ce qui permet le
+// partage sans verrou entre threads (Lazy SMP) ; une collision écrase simplement
+// l'entrée précédente.
+//
+#ifndef EVALCACHE_H
+#define EVALCACHE_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define EVAL_CACHE_DEFAULT_SIZE_KB 1024
+
+typedef struct {
+    uint64_t *entries;
+    uint64_t mask;        // Nombre d'entrées - 1 (puissance de deux)
+} EvalCache;
+
+// Compteurs d'une recherche (un jeu par thread pour PVS v2)
+typedef struct {
+    long probes;
+    long hits;
+} EvalCacheStats;
+
+// Taille arrondie à la puissance de deux inférieure ; 0 si l'allocation échoue
+int eval_cache_init(EvalCache *cache, size_t size_kb);
+void eval_cache_free(EvalCache *cache);
+void eval_cache_clear(EvalCache *cache);
+
+// Clé d'une évaluation : la position (trait et captures compris, state->hash)
+// et le joueur pour qui l'on évalue, les évaluations n'étant pas antisymétriques
+uint64_t eval_cache_key(const GameState *state, PlayerIndex player);
+
+// Score stocké pour key ; les scores doivent tenir sur 16 bits signés
+bool eval_cache_probe(const EvalCache *cache, uint64_t key, int *score);
+void eval_cache_store(EvalCache *cache, uint64_t key, int score);
+
+#endif // EVALCACHE_H
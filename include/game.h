@@ -5,10 +5,12 @@
 #define GAME_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #define NUM_HOLES 16
 #define HOLES_PER_PLAYER 8
 #define NUM_COLORS 3
+#define TOTAL_SEEDS 96
 
 typedef enum {
     RED = 0,
@@ -21,35 +23,103 @@ typedef enum {
     PLAYER_2 = 1     // Trous pairs (2,4,6,8,10,12,14,16)
 } PlayerIndex;
 
+// Agrégats du plateau, tenus à jour par execute_move / make_move pour que
+// is_game_over et l'évaluation n'aient plus à parcourir les 16 trous.
 typedef struct {
-    int seeds[NUM_COLORS];
-} Hole;
+    uint8_t total;            // Graines sur le plateau
+    uint8_t seeds[2];         // Graines dans les trous de chaque joueur
+    uint8_t singles[2];       // Trous du joueur à exactement 1 graine
+    uint8_t capturable[2];    // Trous du joueur à 2 ou 3 graines
+} BoardSummary;
 
+// Plateau compact : 96 graines au total, donc chaque compteur tient sur un octet.
+// Disposition color-major : seeds[couleur][trou] donne une ligne de 16 octets par
+// couleur ; le plateau et ses agrégats tiennent dans une ligne de cache, suivis
+// de la clé Zobrist (72 octets au total).
 typedef struct {
-    Hole board[NUM_HOLES];
-    int captures[2];
-    PlayerIndex current_player;
-    int turn_number;
+    uint8_t seeds[NUM_COLORS][NUM_HOLES];
+    uint8_t captures[2];
+    uint8_t current_player;   // PlayerIndex
+    BoardSummary summary;
+    uint16_t turn_number;
+    uint64_t hash;            // Clé Zobrist (plateau, captures, joueur), tenue à jour par make_move
 } GameState;
 
+// Masque 16 bits (bit i = index i) des trous d'un joueur
+#define PLAYER_HOLES_MASK(player) ((player) == PLAYER_1 ? 0x5555u : 0xAAAAu)
+
 typedef struct {
     int hole_number;          // 1-16 (numéro d'affichage)
     Color color;              // RED, BLUE, ou TRANSPARENT
     Color transparent_color;  // Si color==TRANSPARENT : RED ou BLUE (couleur réelle pour la distribution)
 } Move;
 
+// Enregistrement d'annulation rempli par make_move : paramètres du sowing (rejoué
+// à l'envers), contenu des trous capturés et champs captures/joueur/tour.
+typedef struct {
+    uint8_t hole;                 // Index du trou de départ (0-15)
+    uint8_t color;                // Couleur de distribution (RED ou BLUE)
+    uint8_t sown_transparent;     // Graines transparentes semées
+    uint8_t sown_colored;         // Graines de la couleur semées
+    uint16_t captured_mask;       // Bit i = trou i vidé par la capture
+    uint8_t captured[NUM_COLORS][NUM_HOLES];  // Contenu des trous capturés
+    uint8_t captures[2];
+    uint8_t current_player;
+    BoardSummary summary;
+    uint16_t turn_number;
+    uint64_t hash;
+} MoveUndo;
+
+// Coup compressé sur un octet : index du trou (4 bits), couleur (2 bits),
+// couleur réelle d'un transparent (1 bit)
+#define MOVE_NONE 0xFF
+
+static inline uint8_t pack_move(const Move *move) {
+    uint8_t packed = (uint8_t)((move->hole_number - 1) | (move->color << 4));
+    if (move->color == TRANSPARENT) packed |= (uint8_t)(move->transparent_color << 6);
+    return packed;
+}
+
+static inline Move unpack_move(uint8_t packed) {
+    Move move;
+    move.hole_number = (packed & 0x0F) + 1;
+    move.color = (Color)((packed >> 4) & 0x03);
+    move.transparent_color = (Color)((packed >> 6) & 0x01);
+    return move;
+}
+
+// Accesseurs du plateau (hole_index : 0-15)
+static inline int get_seeds(const GameState *state, int hole_index, Color color) {
+    return state->seeds[color][hole_index];
+}
+
+// Après une série de set_seeds, appeler update_board_summary puis recalculer
+// state->hash avec compute_hash
+static inline void set_seeds(GameState *state, int hole_index, Color color, int count) {
+    state->seeds[color][hole_index] = (uint8_t)count;
+}
+
+static inline int get_total_seeds_in_hole(const GameState *state, int hole_index) {
+    return state->seeds[RED][hole_index] + state->seeds[BLUE][hole_index] +
+           state->seeds[TRANSPARENT][hole_index];
+}
+
 // Fonctions utilitaires
 int hole_display_number(int internal_index);
 bool is_player_hole(int hole_index, PlayerIndex playerIndex);
-int get_total_seeds_in_hole(const Hole *hole);
 int get_total_seeds_on_board(const GameState *state);
-int is_valid_move(GameState *state, Move *move);
+// Coup jouable par le joueur au trait (trou à lui, graines de la couleur)
+int is_valid_move(const GameState *state, const Move *move);
+
+// Au plus 4 coups (R, B, TR, TB) par trou du joueur
+#define MAX_LEGAL_MOVES (4 * HOLES_PER_PLAYER)
 int generate_legal_moves(const GameState *state, Move *moves);
 int is_game_over(const GameState *state);
 
 // Initialisation
 void init_game_state(GameState *state);
 void copy_game_state(const GameState *source, GameState *dest);
+void update_board_summary(GameState *state);
 int parse_move(char *move_str, Move *move);
 
 // Affichage
@@ -60,4 +130,46 @@ void display_move(const Move *move);
 // Moteur de jeu
 int execute_move(GameState *state, Move *move);
 
+// Joue un coup complet (captures, changement de joueur, tour) en place
+// et renvoie le nombre de graines capturées ; unmake_move le défait.
+// undo peut être NULL quand le coup n'a pas à être annulé.
+int make_move(GameState *state, const Move *move, MoveUndo *undo);
+void unmake_move(GameState *state, const MoveUndo *undo);
+
+// Coup nu, pour perft simple sur une copie de la position : graines, captures,
+// trait et tour, mais ni clé Zobrist ni agrégats hormis summary.total (le seul
+// que lise is_game_over). La position n'est plus valable pour la recherche
+int make_move_bare(GameState *state, const Move *move);
+
+// Potentiel de capture : graines que prendrait chaque coup, calculées sans
+// jouer les coups (ni copie, ni clé), pour le tri des coups et l'évaluation
+typedef struct {
+    Move moves[2][MAX_LEGAL_MOVES];       // Par joueur, ordre de generate_legal_moves
+    uint8_t captures[2][MAX_LEGAL_MOVES];
+    int count[2];
+    int best[2];                          // Plus grosse capture immédiate de chaque joueur
+} CapturePotential;
+
+// Captures immédiates des coups des deux joueurs, quel que soit le joueur au trait
+void capture_potential(const GameState *state, CapturePotential *potential);
+
+// Captures de chaque coup légal de player (moves peut être NULL) ; renvoie le nombre de coups
+int move_captures(const GameState *state, PlayerIndex player, Move *moves, uint8_t *captures);
+
+// Plus grosse capture immédiate de player, 0 si aucune
+int best_capture(const GameState *state, PlayerIndex player);
+
+// Graines que capturerait move (valeur de retour de make_move), sans le jouer
+int capture_count(const GameState *state, const Move *move);
+
+// Passe le trait sans jouer (null move), en gardant la clé à jour ;
+// un second appel rétablit la position.
+void make_null_move(GameState *state);
+
+// Clé Zobrist recalculée entièrement (hash incrémental : state->hash)
+uint64_t compute_hash(const GameState *state);
+
+// Clé du plateau et du trait seuls, sans les captures (table de finales)
+uint64_t board_key(const GameState *state);
+
 #endif // GAME_H
\ No newline at end of file
@@ -0,0 +1,91 @@
+//
+// gamelog.h - Parties enregistrées en binaire : un octet par coup
+//
+// Fichier : un en-tête, les parties les unes après les autres, puis l'index
+// des décalages de chaque partie. Une partie est un en-tête fixe (joueurs,
+// résultat, cadence) suivi de ses coups (pack_move), complété à 8 octets.
+// Le fichier se projette en mémoire (map_file) : la partie i s'atteint en
+// temps constant, sans lire les autres.
+//
+#ifndef GAMELOG_H
+#define GAMELOG_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define GAMELOG_MAGIC "AWLEGL01"
+#define GAMELOG_NAME_SIZE 16
+
+// Fin de partie
+#define GAMELOG_END_NORMAL 0        // Règles du jeu (captures, plateau, 400 tours)
+#define GAMELOG_END_DISQUALIFIED 1  // Dépassement de temps ou coup refusé par l'arbitre
+#define GAMELOG_END_UNFINISHED 2    // Journal interrompu
+
+#define GAMELOG_DRAW (-1)
+#define GAMELOG_UNKNOWN (-2)
+
+typedef struct {
+    char magic[8];
+    uint64_t count;
+    uint64_t index_offset;          // Début de l'index (count décalages uint64)
+} GameLogHeader;
+
+// 48 octets, suivis de move_count octets de coups
+typedef struct {
+    char players[2][GAMELOG_NAME_SIZE];   // Joueur 1 (A, commence) et joueur 2 (B)
+    uint32_t time_ms;               // Cadence : temps par coup, 0 si inconnu
+    uint16_t move_count;
+    int8_t winner;                  // PLAYER_1, PLAYER_2, GAMELOG_DRAW ou GAMELOG_UNKNOWN
+    uint8_t end;                    // GAMELOG_END_*
+    uint8_t captures[2];            // Captures finales
+    uint8_t reserved[6];
+} GameLogGame;
+
+typedef struct {
+    const uint64_t *offsets;
+    size_t count;
+    uint64_t games_end;             // Fin des parties (début de l'index)
+    void *data;                     // Zone projetée (map_file)
+    size_t size;
+} GameLogFile;
+
+// Projette le fichier en mémoire ; false si absent ou invalide (file reste vide)
+bool gamelog_open(GameLogFile *file, const char *path);
+void gamelog_close(GameLogFile *file);
+
+// En-tête de la partie i ; ses coups suivent (gamelog_moves). NULL si i est
+// hors du fichier ou si la partie déborde (fichier corrompu)
+const GameLogGame *gamelog_game(const GameLogFile *file, size_t i);
+
+static inline const uint8_t *gamelog_moves(const GameLogGame *game) {
+    return (const uint8_t *)(game + 1);
+}
+
+// Position après les ply premiers coups (tous si ply < 0 ou au-delà), sans
+// affichage ni vérification de légalité : les fichiers sont validés à
+// l'écriture. Renvoie le nombre de coups joués
+int gamelog_replay(const GameLogGame *game, int ply, GameState *state);
+
+/* ==== ÉCRITURE ==== */
+
+// Écriture en flux vers un fichier temporaire, renommé à la fermeture
+typedef struct {
+    FILE *file;
+    char path[1024];
+    uint64_t *offsets;
+    size_t count, cap;
+    uint64_t position;              // Décalage courant dans le fichier
+} GameLogWriter;
+
+bool gamelog_writer_open(GameLogWriter *w, const char *path);
+
+// Ajoute une partie : game->move_count coups de moves (pack_move)
+bool gamelog_writer_add(GameLogWriter *w, const GameLogGame *game, const uint8_t *moves);
+
+// Écrit l'index et l'en-tête puis renomme ; false en cas d'erreur d'écriture
+bool gamelog_writer_close(GameLogWriter *w);
+
+#endif // GAMELOG_H
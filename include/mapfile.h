@@ -0,0 +1,15 @@
+//
+// mapfile.h - Fichiers de données projetés en mémoire en lecture seule
+//
+// mmap sous POSIX ; sous Windows le fichier est lu en entier dans un tampon.
+//
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stddef.h>
+
+// Contenu du fichier et sa taille, NULL si absent, vide ou illisible
+void *map_file(const char *path, size_t *size);
+void unmap_file(void *data, size_t size);
+
+#endif // MAPFILE_H
@@ -0,0 +1,41 @@
+//
+// match.h - Exécution de parties en parallèle sur un pool de workers
+//
+#ifndef MATCH_H
+#define MATCH_H
+
+#include "player.h"
+#include "search.h"
+#include <stdbool.h>
+
+#define MATCH_ERROR (-2)
+
+// Une partie à jouer : player1 commence
+typedef struct {
+    const PlayerInfo *player1;
+    const PlayerInfo *player2;
+    int id1, id2;            // Identifiants libres de l'appelant (index dans ses tableaux)
+    unsigned int seed;       // Graine de rand() pour cette partie : résultats reproductibles
+    int threads;             // Threads de recherche par IA (Lazy SMP)
+    SearchLimits limits;     // Limites de recherche par coup, communes aux deux IA
+    int result;              // PLAYER_1, PLAYER_2, -1 (nul) ou MATCH_ERROR
+} MatchGame;
+
+// Renvoie false pour ne plus lancer de nouvelles parties (arrêt anticipé, SPRT) ;
+// les parties déjà en cours sont terminées et rapportées quand même
+typedef bool (*MatchCallback)(const MatchGame *game, void *user);
+
+// Graine déterministe de la partie index d'une série
+unsigned int match_game_seed(unsigned int base_seed, int index);
+
+// Nombre de cœurs disponibles (valeur par défaut du pool)
+int match_default_workers(void);
+
+// Joue toutes les parties, workers à la fois, chacune dans un processus fils
+// épinglé sur un cœur. Les parties les plus longues partent en premier.
+// done est appelé dans le processus parent à la fin de chaque partie.
+// Renvoie le nombre de parties jouées
+int run_match_games(MatchGame *games, int count, int workers, bool verbose,
+                     MatchCallback done, void *user);
+
+#endif // MATCH_H
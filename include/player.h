@@ -2,12 +2,15 @@
 #define PLAYER_H
 
 #include "game.h"
+#include "search.h"
 
-typedef void (*PlayFunction)(const GameState *state, Move *selected_move);
+typedef void (*PlayFunction)(SearchContext *ctx, const GameState *state, Move *selected_move);
 
+// ctx : état propre à cette instance (NULL pour l'humain et les IA sans recherche)
 typedef struct {
     PlayFunction play;
     const char *name;
+    SearchContext *ctx;
 } Player;
 
 Player create_human_player(void);
@@ -17,9 +20,25 @@ Player create_ai_alpha_beta_player(void);
 Player create_ai_alphabeta_player(void);
 Player create_ai_pvs_player(void);
 Player create_ai_pvs_v2_player(void);
+Player create_ai_pvs_v2_threats_player(void);
 Player create_ai_mtdf_player(void);
 Player create_ai_aspiration_player(void);
 
-void human_play(const GameState *state, Move *selected_move);
+// Registre des IA, pour les choisir par nom en ligne de commande
+typedef Player (*PlayerFactory)(void);
+
+typedef struct {
+    const char *id;          // Nom court : "pvs", "pvs_v2", "mtdf"...
+    PlayerFactory create;
+    int move_cost_ms;        // Durée typique d'un coup (ordonnancement des parties)
+} PlayerInfo;
+
+const PlayerInfo *player_registry(int *count);
+const PlayerInfo *find_player(const char *id);
+
+// Libère le contexte de recherche du joueur
+void destroy_player(Player *player);
+
+void human_play(SearchContext *ctx, const GameState *state, Move *selected_move);
 
 #endif
@@ -0,0 +1,238 @@
+//
+// search.h - Contexte de recherche : tout l'état d'une IA entre deux coups
+//
+// Chaque joueur IA possède son propre contexte (table de transposition,
+// killers, historique, chronomètre, statistiques). Deux instances de la même
+// IA peuvent ainsi jouer dans le même processus sans partager leur table.
+//
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "evalcache.h"
+#include "game.h"
+#include "tablebase.h"
+#include "tt.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#define MAX_DEPTH 50
+#define DETERMINISTIC_DEFAULT_NODES 2000000   // Budget si le mode déterministe n'en fixe aucun
+#define SEARCH_WIN_SCORE 90000                // Au-delà, le score est une fin de partie prouvée
+
+// Gestion du temps : la limite dure est le budget du coup, imposée par un minuteur ;
+// la limite souple (fraction du budget plus une part de la banque) décide seulement
+// si une nouvelle itération peut commencer
+#define TIME_SOFT_PERCENT 50       // Limite souple de base, en % de la limite dure
+#define TIME_BANK_SHARE 4          // Un coup peut puiser 1/4 de la banque
+#define TIME_BANK_MAX_MOVES 10     // Banque plafonnée à 10 limites souples
+#define TIME_MIN_GROWTH 2          // Bornes du rapport de durée entre deux itérations,
+#define TIME_MAX_GROWTH 8          // pour prévoir si la suivante tiendra avant la limite dure
+
+// Limites d'une recherche : la première atteinte arrête la recherche.
+// 0 = pas de limite (profondeur, nœuds) ou limite par défaut du moteur (temps)
+typedef struct {
+    int max_depth;
+    long max_nodes;
+    long max_time_ms;
+    int deterministic;     // Ignore l'horloge : mêmes coups et mêmes nœuds sur toute machine
+} SearchLimits;
+
+// Horloge d'un coup et banque de temps de la partie
+typedef struct {
+    long hard_ms;                        // Arrêt forcé par le minuteur
+    long base_soft_ms;                   // Limite souple sans banque ni extension
+    long soft_ms;                        // Pas de nouvelle itération au-delà
+    long bank_ms;                        // Temps économisé sur les coups précédents
+    int root_moves;
+    uint8_t last_best;                   // Meilleur coup (pack_move) de l'itération précédente
+    int instability;                     // Changements récents du meilleur coup
+    long last_iter_end_ms;               // Fin de l'itération précédente, depuis start_time
+    long last_iter_ms;                   // Durée de l'itération précédente
+
+    // Protégés par lock : la réflexion anticipée est pilotée depuis un autre thread
+    pthread_t timer;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int timer_running;
+    int searching;                       // Entre search_start et search_finish
+    int pondering;                       // Recherche pendant le tour adverse, sans limite de temps
+    int abort;                           // Réflexion abandonnée (search_abort)
+    long origin_ms;                      // Début du coup, en ms après start_time (search_ponderhit)
+} TimeManager;
+
+// Statistiques de la dernière recherche
+typedef struct {
+    int completed_depth;
+    int best_score;
+    long nodes;
+    long tt_hits;
+    long tb_hits;                        // Positions tranchées par la table de finales
+    EvalCacheStats eval_cache;           // Évaluations demandées et trouvées dans le cache
+    long cutoffs;
+    long re_searches;                    // Re-recherches PVS, échecs de fenêtre, itérations MTD(f)
+    long elapsed_ms;
+    long depth_time_ms[MAX_DEPTH + 1];   // Temps pour terminer chaque profondeur, -1 si non atteinte
+    int threads;
+} SearchStats;
+
+typedef struct SearchContext {
+    TranspositionTable tt;
+    EvalCache eval_cache;                // Partagé par les threads comme la table
+    Move killers[MAX_DEPTH][2];
+    int history[NUM_HOLES][3];           // History heuristic [hole][color]
+
+    SearchLimits limits;
+    TimeManager time;
+
+    struct timespec start_time;
+    int time_exceeded;
+    atomic_int stop;                     // Arrêt partagé entre les threads, levé par le minuteur
+
+    int num_threads;                     // Lazy SMP (PVS v2), 1 par défaut
+    const Tablebase *tablebase;          // Table de finales (PVS, PVS v2), NULL = aucune
+    int eval_threats;                    // Menaces de capture dans cached_evaluate, 0 par défaut
+    void *engine_data;                   // État propre à un moteur, alloué par malloc
+
+    SearchStats stats;
+} SearchContext;
+
+// Alloue un contexte, sa table (taille tt_default_size_mb) et son cache
+// d'évaluation ; NULL si échec
+SearchContext *search_create(void);
+void search_destroy(SearchContext *ctx);
+
+// Nouvelle partie : oublie tout ce qui a été appris (table, cache d'évaluation,
+// killers, historique)
+// et vide la banque de temps
+void search_clear(SearchContext *ctx);
+
+// Début d'un coup : nouvelle génération de table, chronomètre, statistiques à zéro,
+// minuteur de la limite dure. default_time_ms est le budget du moteur quand
+// limits.max_time_ms vaut 0 ; root_moves le nombre de coups légaux
+void search_start(SearchContext *ctx, long default_time_ms, int root_moves);
+
+// Fin d'une itération complète : faut-il lancer la profondeur suivante ?
+// Non s'il n'y a qu'un coup, si la partie est jouée, si la limite souple est
+// passée (prolongée quand le meilleur coup vient de changer) ou si la suivante
+// ne peut pas finir avant la limite dure
+int search_continue(SearchContext *ctx, const Move *best, int best_score);
+
+// Fin du coup : arrête le minuteur, met à jour la banque et stats.elapsed_ms
+void search_finish(SearchContext *ctx);
+
+// Coup joué sans recherche (livre d'ouvertures) : la limite souple de base
+// du coup part entière en banque
+void search_bank_move(SearchContext *ctx, long default_time_ms);
+
+// Réflexion anticipée pendant le tour adverse. search_ponder marque la prochaine
+// recherche comme illimitée, avant de la lancer dans un autre thread. Si
+// l'adversaire joue le coup prévu, search_ponderhit la transforme en recherche
+// normale dont l'horloge part de maintenant ; sinon search_abort l'arrête
+// (la table de transposition reste chaude pour la vraie recherche)
+void search_ponder(SearchContext *ctx);
+void search_ponderhit(SearchContext *ctx);
+void search_abort(SearchContext *ctx);
+
+// Temps réel écoulé depuis search_start
+long search_elapsed_ms(const SearchContext *ctx);
+
+// Profondeur maximale de l'iterative deepening
+static inline int search_max_depth(const SearchContext *ctx) {
+    int d = ctx->limits.max_depth;
+    return (d > 0 && d < MAX_DEPTH) ? d : MAX_DEPTH;
+}
+
+// Budget de nœuds effectif (0 = illimité)
+static inline long search_node_budget(const SearchContext *ctx) {
+    if (ctx->limits.max_nodes > 0) return ctx->limits.max_nodes;
+    if (ctx->limits.deterministic && ctx->limits.max_depth <= 0) return DETERMINISTIC_DEFAULT_NODES;
+    return 0;
+}
+
+// Vérifie les limites pour le nœud numéro nodes (compté par l'appelant) :
+// budget de nœuds exact, drapeau d'arrêt levé par le minuteur
+static inline int search_limit_reached(SearchContext *ctx, long nodes, long node_budget) {
+    if (node_budget > 0 && nodes >= node_budget) return 1;
+    return atomic_load_explicit(&ctx->stop, memory_order_relaxed);
+}
+
+// Même coup au sens de la table (pack_move) : TR et TB d'un même trou diffèrent.
+// Sert à toutes les comparaisons avec le coup de la table et les killers
+static inline int same_move(const Move *a, const Move *b) {
+    return pack_move(a) == pack_move(b);
+}
+
+/* ==== ENFANTS D'UN NŒUD ==== */
+
+// Profondeur restante à partir de laquelle le tri regarde la réponse adverse :
+// plus bas, le calcul coûte plus que les nœuds qu'il fait économiser
+#define NET_GAIN_MIN_DEPTH 4
+
+// Enfant d'un nœud : la position après le coup (clé comprise) et les graines
+// capturées, calculées une seule fois pour le tri et pour la recherche
+typedef struct {
+    GameState state;
+    Move move;
+    int captured;
+    int score;                     // Clé de tri
+} SearchChild;
+
+// Enfants d'un nœud, servis du meilleur au moins bon à la demande : une
+// coupure au premier coup n'a trié qu'un seul enfant
+typedef struct {
+    SearchChild child[MAX_LEGAL_MOVES];
+    uint8_t order[MAX_LEGAL_MOVES];
+    int count, next;
+} ChildList;
+
+// Joue chaque coup légal sur une copie de state ; renvoie le nombre d'enfants.
+// Les clés de tri sont à remplir ensuite (score_children ou propres au moteur)
+int generate_children(const GameState *state, ChildList *list);
+
+// Clés de order_moves : coup de la table, killers du ply, puis captures. À partir
+// de NET_GAIN_MIN_DEPTH, les captures sont diminuées de la meilleure réponse
+// adverse (potentiel de capture de l'enfant) : gain net sur deux plis
+void score_children(ChildList *list, const Move (*killers)[2], int ply, const Move *tt_move, int depth);
+
+// Enfant suivant par clé décroissante (premier rencontré à égalité), NULL à la fin
+SearchChild *next_child(ChildList *list);
+
+/* ==== SÉLECTION ÉTAGÉE DES COUPS ==== */
+
+// Étapes du sélecteur : chacune n'est préparée que si les précédentes n'ont
+// pas coupé. Le coup de la table se joue sans rien générer ; la génération
+// (avec le potentiel de capture de chaque coup) n'a lieu qu'après les killers
+typedef enum {
+    PICK_TT_MOVE,
+    PICK_KILLERS,
+    PICK_GENERATE,
+    PICK_CAPTURES,                 // Par graines capturées décroissantes
+    PICK_QUIET,                    // Par historique décroissant
+    PICK_DONE
+} PickStage;
+
+typedef struct {
+    const GameState *state;
+    PickStage stage;
+    uint8_t tt_move;               // pack_move, MOVE_NONE si absent ou illégal
+    uint8_t killers[2];            // Killers déjà servis, MOVE_NONE sinon
+    Move killer_moves[2];
+    int killer_index;
+    const int (*history)[NUM_COLORS];
+
+    Move moves[MAX_LEGAL_MOVES];   // Captures en [0, capture_end), calmes ensuite
+    int scores[MAX_LEGAL_MOVES];
+    int next, capture_end, count;
+} MovePicker;
+
+// killers : les deux killers du ply (NULL si aucun) ; history[trou][couleur]
+// ordonne les coups calmes (NULL : ordre de génération)
+void picker_init(MovePicker *picker, const GameState *state, const Move *tt_move,
+                 const Move *killers, const int (*history)[NUM_COLORS]);
+
+// Joue le coup suivant dans child (position, coup, graines capturées) ;
+// 0 quand tous les coups légaux ont été servis
+int picker_next(MovePicker *picker, SearchChild *child);
+
+#endif // SEARCH_H
@@ -0,0 +1,91 @@
+//
+// selfplay.h - Fichier de positions étiquetées, pour régler l'évaluation
+//
+// Un en-tête, count enregistrements de taille fixe dans l'ordre de génération,
+// puis l'index : les clés triées avec le numéro de leur enregistrement. Le
+// fichier se projette en mémoire (map_file) : l'enregistrement i est à un
+// décalage fixe, une position se retrouve par dichotomie dans l'index.
+// Chaque position (state->hash) n'y figure qu'une fois.
+//
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define SELFPLAY_MAGIC "AWLESP01"
+#define SELFPLAY_DEFAULT_PATH "selfplay.bin"
+
+typedef struct {
+    char magic[8];
+    uint32_t record_size;      // sizeof(SelfplayRecord), pour les lecteurs
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t index_offset;     // Début de l'index, en octets depuis le début du fichier
+} SelfplayHeader;
+
+// 64 octets
+typedef struct {
+    uint8_t seeds[NUM_COLORS][NUM_HOLES];
+    uint8_t captures[2];
+    uint8_t side;              // Joueur au trait
+    uint8_t move;              // Meilleur coup de la recherche (pack_move)
+    int32_t score;             // Score de la recherche, du point de vue du joueur au trait
+    uint16_t turn_number;
+    int8_t result;             // Résultat final pour le joueur au trait : 1, 0 (nul), -1
+    uint8_t depth;             // Profondeur complète atteinte
+    uint32_t game;             // Numéro de la partie dans sa série
+} SelfplayRecord;
+
+typedef struct {
+    uint64_t key;              // state->hash
+    uint64_t record;
+} SelfplayIndexEntry;
+
+typedef struct {
+    const SelfplayRecord *records;
+    const SelfplayIndexEntry *index;
+    size_t count;
+    void *data;                // Zone projetée (map_file)
+    size_t size;
+} SelfplayFile;
+
+// Projette le fichier en mémoire ; false si absent ou invalide (file reste vide)
+bool selfplay_open(SelfplayFile *file, const char *path);
+void selfplay_close(SelfplayFile *file);
+
+// Enregistrement de la position de clé key, par dichotomie dans l'index
+const SelfplayRecord *selfplay_find(const SelfplayFile *file, uint64_t key);
+
+// Conversions entre position et enregistrement (agrégats et clé recalculés)
+void selfplay_pack(const GameState *state, SelfplayRecord *record);
+void selfplay_unpack(const SelfplayRecord *record, GameState *state);
+
+/* ==== ÉCRITURE ==== */
+
+// Écriture en flux : les enregistrements partent dans un fichier temporaire au
+// fil de l'eau, l'index et l'en-tête à la fermeture, qui renomme le fichier.
+// Pas de verrou : un seul thread écrit à la fois
+typedef struct {
+    FILE *file;
+    char path[1024];
+    SelfplayIndexEntry *index;  // Dans l'ordre des enregistrements
+    size_t count, cap;
+    uint64_t *slots;            // Clés déjà écrites (table ouverte), 0 = vide
+    size_t mask;
+} SelfplayWriter;
+
+// Reprend les positions d'un fichier existant s'il y en a un
+bool selfplay_writer_open(SelfplayWriter *w, const char *path);
+
+// Ajoute l'enregistrement de la position key ; false si elle est déjà écrite
+// (ou si l'écriture échoue)
+bool selfplay_writer_add(SelfplayWriter *w, uint64_t key, const SelfplayRecord *record);
+
+// Écrit l'index et l'en-tête puis renomme ; false en cas d'erreur d'écriture
+bool selfplay_writer_close(SelfplayWriter *w);
+
+#endif // SELFPLAY_H
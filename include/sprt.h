@@ -0,0 +1,35 @@
+//
+// sprt.h - Test séquentiel du rapport de vraisemblance (SPRT) entre deux IA
+//
+// Les parties sont jouées par paires (même graine, premier joueur inversé).
+// Chaque paire donne 0, 0.5, 1, 1.5 ou 2 points à l'IA testée : ces cinq
+// effectifs (statistiques pentanomiales) suffisent pour le LLR et l'Elo.
+//
+#ifndef SPRT_H
+#define SPRT_H
+
+#define SPRT_CONTINUE 0
+#define SPRT_ACCEPT_H0 1     // L'écart d'Elo est <= elo0
+#define SPRT_ACCEPT_H1 2     // L'écart d'Elo est >= elo1
+
+typedef struct {
+    double elo0, elo1;       // Hypothèses H0 / H1 (Elo logistique)
+    double alpha, beta;      // Risques de première et deuxième espèce
+    int penta[5];            // Paires ayant rapporté 0, 0.5, 1, 1.5, 2 points
+    int wins, losses, draws; // Du point de vue de l'IA testée
+} Sprt;
+
+void sprt_init(Sprt *sprt, double elo0, double elo1, double alpha, double beta);
+
+// Ajoute une paire : score de chaque partie (1 victoire, 0.5 nul, 0 défaite)
+void sprt_add_pair(Sprt *sprt, double score1, double score2);
+
+int sprt_pairs(const Sprt *sprt);
+double sprt_llr(const Sprt *sprt);
+void sprt_bounds(const Sprt *sprt, double *lower, double *upper);
+int sprt_status(const Sprt *sprt);
+
+// Elo estimé et demi-largeur de l'intervalle de confiance à 95 %
+void sprt_elo(const Sprt *sprt, double *elo, double *error95);
+
+#endif // SPRT_H
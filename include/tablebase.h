@@ -0,0 +1,61 @@
+//
+// tablebase.h - Table de finales : valeur exacte des positions à peu de graines
+//
+// Pour chaque position (plateau et trait, sans les captures), la marge de
+// captures que le joueur au trait obtient encore en jeu parfait. Avec la
+// différence de captures actuelle, elle donne le résultat exact de la partie :
+// atteindre 49 captures scelle un résultat que le décompte final donnerait aussi.
+//
+// Seules les positions résolues exactement y figurent ; les autres se cherchent.
+// Les marges supposent une partie sans limite de tours : l'en-tête donne
+// l'horizon, demi-coups qui suffisent à toute ligne forcée de la résolution.
+// Une position plus proche de la fin (tour 400) que l'horizon n'est pas sondée.
+// Fichier : un en-tête, count clés triées (board_key) puis count marges (int8).
+// Produit par build_tablebase (make tablebase), projeté en mémoire à l'usage.
+//
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TB_MAGIC "AWLETB02"
+#define TB_DEFAULT_PATH "endgame.tb"
+#define TB_WIN_SCORE 95000     // Victoire prouvée : au-delà de SEARCH_WIN_SCORE, sous WIN_SCORE - MAX_TURNS
+#define TB_LAST_TURN 400       // Dernier tour joué (is_game_over)
+
+typedef struct {
+    char magic[8];
+    uint32_t max_seeds;        // Graines sur le plateau des positions les plus grosses
+    uint32_t horizon;          // Demi-coups suffisant à réaliser toutes les marges
+    uint64_t count;
+} TablebaseHeader;
+
+typedef struct {
+    const uint64_t *keys;
+    const int8_t *margins;
+    size_t count;
+    int max_seeds;
+    int horizon;
+    void *data;                // Zone projetée (map_file)
+    size_t size;
+} Tablebase;
+
+// Projette la table en mémoire ; false si absente ou invalide (tb reste vide)
+bool tb_open(Tablebase *tb, const char *path);
+void tb_close(Tablebase *tb);
+
+// Marge de captures future du joueur au trait, en jeu parfait
+bool tb_probe(const Tablebase *tb, const GameState *state, int *margin);
+
+// Score exact de la position pour player : ±(TB_WIN_SCORE + écart final) ou 0 (nul).
+// false si la position n'est pas couverte (trop de graines, absente) ou si la
+// limite de tours arrive avant l'horizon
+bool tb_probe_score(const Tablebase *tb, const GameState *state, PlayerIndex player, int *score);
+
+// Trie les paires (clé, marge) et écrit la table ; false en cas d'erreur
+bool tb_write(const char *path, int max_seeds, int horizon, uint64_t *keys, int8_t *margins, size_t count);
+
+#endif // TABLEBASE_H
@@ -0,0 +1,73 @@
+//
+// tt.h - Table de transposition partagée par toutes les IA
+//
+#ifndef TT_H
+#define TT_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TT_EXACT 0
+#define TT_LOWER 1
+#define TT_UPPER 2
+
+#define TT_DEFAULT_SIZE_MB 16
+#define TT_BUCKET_ENTRIES 4
+
+// Vue décodée d'une entrée, remplie par tt_probe
+typedef struct {
+    uint64_t key;         // Clé Zobrist complète
+    int32_t score;
+    int8_t depth;
+    uint8_t flag;         // TT_EXACT / TT_LOWER / TT_UPPER
+    uint8_t move;         // Coup compressé (pack_move), MOVE_NONE si aucun
+    uint8_t generation;   // Recherche qui a écrit l'entrée (vieillissement)
+} TTEntry;
+
+// Stockage compact (16 octets) : 4 slots par bucket de 64 octets = une ligne de cache.
+// check = clé ^ data : une écriture concurrente à moitié faite ne passe pas la
+// validation, ce qui permet le partage sans verrou entre threads (Lazy SMP)
+typedef struct {
+    uint64_t check;       // 0 avec data = 0 : slot vide
+    uint64_t data;        // score | depth | flag | move | generation
+} TTSlot;
+
+typedef struct {
+    TTSlot slots[TT_BUCKET_ENTRIES];
+} TTBucket;
+
+typedef struct {
+    TTBucket *buckets;
+    uint64_t mask;        // Nombre de buckets - 1 (puissance de deux)
+    uint8_t generation;
+} TranspositionTable;
+
+// Taille à l'exécution, arrondie à la puissance de deux inférieure ; 0 si l'allocation échoue
+int tt_init(TranspositionTable *tt, size_t size_mb);
+void tt_free(TranspositionTable *tt);
+void tt_clear(TranspositionTable *tt);
+
+// Taille utilisée par les IA qui allouent leur table au premier coup
+void tt_set_default_size_mb(size_t size_mb);
+size_t tt_default_size_mb(void);
+
+// À appeler au début de chaque coup : les entrées des recherches précédentes
+// restent utilisables mais sont remplacées en priorité
+void tt_new_search(TranspositionTable *tt);
+
+// Copie l'entrée de la position dans out si elle est présente.
+// Probe et store peuvent être appelés en parallèle sur la même table
+bool tt_probe(const TranspositionTable *tt, uint64_t key, TTEntry *out);
+void tt_store(TranspositionTable *tt, uint64_t key, int depth, int score, int flag, const Move *best_move);
+
+static inline void tt_prefetch(const TranspositionTable *tt, uint64_t key) {
+#if defined(__GNUC__)
+    __builtin_prefetch(&tt->buckets[key & tt->mask]);
+#else
+    (void)tt; (void)key;
+#endif
+}
+
+#endif // TT_H
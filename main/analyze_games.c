@@ -0,0 +1,287 @@
+//
+// analyze_games.c - Analyse en lot des positions de parties enregistrées
+//
+// Chaque position de chaque partie (fichiers gamelog, voir convert_games) est
+// cherchée à profondeur ou nombre de nœuds fixe, par plusieurs threads ayant
+// chacun leur contexte. Si le coup joué n'est pas le meilleur, la position qui
+// le suit est cherchée aussi : la perte est l'écart entre le score du meilleur
+// coup et celui du coup joué, du point de vue du joueur au trait. La table est
+// vidée avant chaque position : le rapport ne dépend pas du nombre de threads.
+//
+// Rapport CSV, une ligne par coup, dans l'ordre des parties :
+//   game,ply,player,played,best,score,played_score,drop,depth,nodes
+//
+// Usage : analyze_games [-depth d] [-nodes n] [-j threads] [-engine ia]
+//                       [-hash MB] [-o rapport.csv] parties.bin ...
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/ai_common.h"
+#include "../include/game.h"
+#include "../include/gamelog.h"
+#include "../include/match.h"
+#include "../include/player.h"
+#include "../include/tt.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_NODES 100000
+#define DEFAULT_HASH_MB 4          // Vidée à chaque position : petite table
+#define DEFAULT_OUTPUT "analysis.csv"
+#define BLUNDER_DROP 200           // Perte de deux graines ou plus
+#define PROGRESS_EVERY 1000
+#define MAX_THREADS 64
+#define MAX_FILES 256
+
+// Une position à chercher : avant le coup ply de la partie game
+typedef struct {
+    const GameLogGame *game;
+    uint32_t game_number;          // Numéro dans le corpus (tous fichiers confondus)
+    uint16_t ply;
+} AnalysisJob;
+
+typedef struct {
+    int32_t score;                 // Meilleur coup, point de vue du joueur au trait
+    int32_t played_score;          // Coup joué, même point de vue
+    long nodes;
+    uint8_t best;                  // pack_move
+    uint8_t depth;
+    uint8_t player;                // Joueur au trait
+} AnalysisResult;
+
+typedef struct {
+    AnalysisJob *jobs;
+    AnalysisResult *results;
+    long count;
+    atomic_long next;
+    atomic_long done;
+
+    const PlayerInfo *engine;
+    SearchLimits limits;
+    struct timespec start;
+    pthread_mutex_t lock;          // Affichage de la progression
+} Analysis;
+
+static double seconds_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void format_move(char *buf, size_t size, uint8_t packed) {
+    Move m = unpack_move(packed);
+    if (m.color == TRANSPARENT) snprintf(buf, size, "%dT%s", m.hole_number, m.transparent_color == RED ? "R" : "B");
+    else snprintf(buf, size, "%d%s", m.hole_number, m.color == RED ? "R" : "B");
+}
+
+/* ==== RECHERCHE ==== */
+
+// Cherche state dans un contexte vidé ; score du point de vue du joueur au trait
+static int search_position(Player *ai, const GameState *state, Move *best, long *nodes, int *depth) {
+    search_clear(ai->ctx);
+    ai->play(ai->ctx, state, best);
+    *nodes += ai->ctx->stats.nodes;
+    *depth = ai->ctx->stats.completed_depth;
+    return ai->ctx->stats.best_score;
+}
+
+static void analyze_position(Player *ai, const AnalysisJob *job, AnalysisResult *r) {
+    GameState state;
+    gamelog_replay(job->game, job->ply, &state);
+    uint8_t played = gamelog_moves(job->game)[job->ply];
+    r->player = (uint8_t)state.current_player;
+
+    Move best;
+    int depth;
+    r->nodes = 0;
+    r->score = search_position(ai, &state, &best, &r->nodes, &depth);
+    r->best = pack_move(&best);
+    r->depth = (uint8_t)depth;
+    if (played == r->best) {
+        r->played_score = r->score;
+        return;
+    }
+
+    // Coup joué : la position suivante, cherchée un cran moins profond
+    PlayerIndex mover = state.current_player;
+    Move move = unpack_move(played);
+    make_move(&state, &move, NULL);
+    if (is_game_over(&state) || generate_legal_moves(&state, (Move[128]){0}) == 0) {
+        r->played_score = base_evaluate(&state, mover);
+        return;
+    }
+
+    SearchLimits saved = ai->ctx->limits;
+    if (saved.max_depth > 1) ai->ctx->limits.max_depth = saved.max_depth - 1;
+    Move reply;
+    int reply_depth;
+    r->played_score = -search_position(ai, &state, &reply, &r->nodes, &reply_depth);
+    ai->ctx->limits = saved;
+}
+
+static void *worker_main(void *arg) {
+    Analysis *a = arg;
+    Player ai = a->engine->create();
+    ai.ctx->limits = a->limits;
+
+    long i;
+    while ((i = atomic_fetch_add(&a->next, 1)) < a->count) {
+        analyze_position(&ai, &a->jobs[i], &a->results[i]);
+
+        long done = atomic_fetch_add(&a->done, 1) + 1;
+        if (done % PROGRESS_EVERY == 0 || done == a->count) {
+            double s = seconds_since(&a->start);
+            pthread_mutex_lock(&a->lock);
+            printf("[%ld/%ld] %.0f positions/s\n", done, a->count, s > 0 ? done / s : 0.0);
+            fflush(stdout);
+            pthread_mutex_unlock(&a->lock);
+        }
+    }
+
+    destroy_player(&ai);
+    return NULL;
+}
+
+/* ==== CORPUS ET RAPPORT ==== */
+
+// Une tâche par coup de chaque partie lisible des fichiers
+static long collect_jobs(GameLogFile *files, int file_count, AnalysisJob **out) {
+    long count = 0;
+    for (int f = 0; f < file_count; f++) {
+        for (size_t g = 0; g < files[f].count; g++) {
+            const GameLogGame *game = gamelog_game(&files[f], g);
+            if (game) count += game->move_count;
+        }
+    }
+
+    AnalysisJob *jobs = malloc(count * sizeof(AnalysisJob) + 1);
+    if (!jobs) return -1;
+
+    long k = 0;
+    uint32_t number = 0;
+    for (int f = 0; f < file_count; f++) {
+        for (size_t g = 0; g < files[f].count; g++, number++) {
+            const GameLogGame *game = gamelog_game(&files[f], g);
+            if (!game) {
+                fprintf(stderr, "Partie %zu illisible, ignorée\n", g);
+                continue;
+            }
+            for (int ply = 0; ply < game->move_count; ply++) {
+                jobs[k++] = (AnalysisJob){ game, number, (uint16_t)ply };
+            }
+        }
+    }
+    *out = jobs;
+    return k;
+}
+
+static int write_report(const Analysis *a, const char *path) {
+    FILE *out = fopen(path, "w");
+    if (!out) return 0;
+
+    long blunders[2] = {0}, moves[2] = {0};
+    double drops[2] = {0};
+    fprintf(out, "game,ply,player,played,best,score,played_score,drop,depth,nodes\n");
+    for (long i = 0; i < a->count; i++) {
+        const AnalysisJob *job = &a->jobs[i];
+        const AnalysisResult *r = &a->results[i];
+        int player = r->player;
+        int drop = r->score - r->played_score;
+        char played[8], best[8];
+        format_move(played, sizeof(played), gamelog_moves(job->game)[job->ply]);
+        format_move(best, sizeof(best), r->best);
+        fprintf(out, "%u,%d,%c,%s,%s,%d,%d,%d,%d,%ld\n", job->game_number, job->ply + 1,
+                player == PLAYER_1 ? 'A' : 'B', played, best, r->score, r->played_score, drop, r->depth, r->nodes);
+
+        moves[player]++;
+        drops[player] += drop > 0 ? drop : 0;
+        blunders[player] += drop >= BLUNDER_DROP;
+    }
+    int ok = fclose(out) == 0;
+
+    for (int p = 0; p < 2; p++) {
+        printf("Joueur %c : %ld coups, perte moyenne %.1f, %ld pertes >= %d\n", p == PLAYER_1 ? 'A' : 'B',
+               moves[p], moves[p] ? drops[p] / moves[p] : 0.0, blunders[p], BLUNDER_DROP);
+    }
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    int threads = match_default_workers();
+    const char *path = DEFAULT_OUTPUT, *engine = "pvs";
+    const char *inputs[MAX_FILES];
+    int input_count = 0;
+    Analysis a = { .limits = { .deterministic = 1 } };
+    tt_set_default_size_mb(DEFAULT_HASH_MB);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-depth") == 0 && i + 1 < argc) a.limits.max_depth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-nodes") == 0 && i + 1 < argc) a.limits.max_nodes = atol(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-engine") == 0 && i + 1 < argc) engine = argv[++i];
+        else if (strcmp(argv[i], "-hash") == 0 && i + 1 < argc) tt_set_default_size_mb((size_t)atoi(argv[++i]));
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) path = argv[++i];
+        else if (input_count < MAX_FILES) inputs[input_count++] = argv[i];
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (a.limits.max_depth <= 0 && a.limits.max_nodes <= 0) a.limits.max_nodes = DEFAULT_NODES;
+    if (input_count == 0) {
+        fprintf(stderr, "Usage : analyze_games [-depth d] [-nodes n] [-j threads] [-engine ia] "
+                        "[-hash MB] [-o rapport.csv] parties.bin ...\n");
+        return 1;
+    }
+
+    a.engine = find_player(engine);
+    Player probe = a.engine ? a.engine->create() : (Player){0};
+    int searches = probe.ctx != NULL;
+    if (a.engine) destroy_player(&probe);
+    if (!searches) {
+        fprintf(stderr, "IA de recherche inconnue ou sans contexte : %s\n", engine);
+        return 1;
+    }
+
+    GameLogFile files[MAX_FILES];
+    int file_count = 0;
+    for (int i = 0; i < input_count; i++) {
+        if (gamelog_open(&files[file_count], inputs[i])) file_count++;
+        else fprintf(stderr, "Fichier de parties illisible : %s\n", inputs[i]);
+    }
+
+    a.count = collect_jobs(files, file_count, &a.jobs);
+    a.results = a.count >= 0 ? calloc(a.count + 1, sizeof(AnalysisResult)) : NULL;
+    if (!a.results) {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return 1;
+    }
+    printf("=== ANALYSE === %ld positions, %s, nœuds %ld, profondeur %d, %d threads\n",
+           a.count, engine, a.limits.max_nodes, a.limits.max_depth, threads);
+
+    pthread_mutex_init(&a.lock, NULL);
+    atomic_init(&a.next, 0);
+    atomic_init(&a.done, 0);
+    clock_gettime(CLOCK_MONOTONIC, &a.start);
+
+    pthread_t handles[MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < threads && t < a.count; t++) {
+        if (pthread_create(&handles[t], NULL, worker_main, &a) != 0) break;
+        started++;
+    }
+    if (started == 0 && a.count > 0) worker_main(&a);
+    for (int t = 0; t < started; t++) pthread_join(handles[t], NULL);
+    pthread_mutex_destroy(&a.lock);
+
+    int ok = write_report(&a, path);
+    if (ok) printf("Rapport écrit : %s (%.1fs)\n", path, seconds_since(&a.start));
+    else fprintf(stderr, "Écriture de %s impossible\n", path);
+
+    free(a.jobs);
+    free(a.results);
+    for (int f = 0; f < file_count; f++) gamelog_close(&files[f]);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,407 @@
+//
+// bench.c - Microbenchmarks des primitives du moteur de jeu
+//
+// Mesure le coût (ns/op) des fonctions appelées à chaque nœud de recherche,
+// sur un corpus fixe de positions de milieu de partie. Chaque mesure est
+// répétée après un échauffement ; on rapporte la médiane et le 95e centile.
+//
+// Usage : bench [-reps N] [-csv | -json]
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/game.h"
+#include "../include/ai_common.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_REPS 21
+#define WARMUP_REPS 3
+#define MAX_REPS 1000
+#define TARGET_OPS 200000     // Opérations par répétition, environ
+
+/* ==== CORPUS ==== */
+
+// Positions enregistrées : parties à graine fixe, un coup sur deux en
+// capturant le plus possible, arrêtées entre le 20e et le 59e coup
+static const char *corpus_moves[] = {
+    "5B 8TB 3TB 10TB 9TB 16TB 1B 14R 1R 6R 13B 14TB 5TR 2TB 1TB 2TB 7B 14B 5TR 6TB",
+    "1R 14TR 7TB 8TB 3TR 2R 9TB 6R 1B 6TR 5TB 4B 5R 16TR 13TB 12R 1TB 10R 9B 16TR 15TB 16TB 3B",
+    "5TR 2B 11TR 8TB 11TB 12TR 13R 10R 1R 4R 1B 6TB 13TR 8R 3R 4R 15TR 4R 1TB 2R 13B 16TB 5TB 2B 13B 4B",
+    "1R 16TB 3R 12TR 3B 8TR 3TB 10TB 1TB 2TR 13TR 12B 11TR 4TR 9TB 10R 7R 6B 5B 4B 7TR 6TB 1B 16TR 1TR 14TR 15R 6R 5R",
+    "1TB 6TB 3B 14B 11R 16R 11TB 4TB 9TB 10TR 5R 16TB 7TR 8R 11TB 2TB 15B 8TB 3TR 14TR 5R 4B 5TR 12TB 7TB 6TR 5TR 2TB 5B 16B 13TB 8TR",
+    "1R 6TB 7TB 4R 3B 10R 3R 12TB 5R 2TR 3TR 10TB 11TR 12R 1TB 10B 1R 8R 5TB 4TR 15B 14B 15R 6TR 9B 8B 7R 8R 7TR 8TR 13TB 16TR 1TB 14TR 7R",
+    "13R 12TR 3TB 16TB 7B 2R 1R 6R 5R 10B 5TB 14TB 1TR 10R 1B 2R 3R 6R 9TB 2B 3B 2TR 3TR 10TR 7B 6TB 1B 16R 13B 12TB 11TR 4R 7R 4TR 7TR 10TR 5R 4B",
+    "7R 2R 9B 4TR 3TR 10TB 1R 8R 1TR 2R 5TR 8B 15TR 16TB 11B 2R 1TB 2B 9B 6TB 11R 14R 15R 10R 9TB 14B 11TR 12R 7TB 14TB 15R 10TR 5B 8TB 5TR 4TR 13R 12TB 9R 2R 11R",
+    "5R 2R 1R 4B 9R 2R 3R 2B 11TB 6R 1B 16R 3B 14TR 7TR 12TR 13TB 8R 9TR 8B 5B 2TR 13B 6B 5R 10B 7B 12B 3TR 16R 9B 16B 11TR 10TR 13R 16TR 15B 8TB 11TR 4TB 13TB 16TB 5TR 14TR",
+    "1R 2R 7B 14TR 11B 2R 1R 4TR 15TR 6TB 3B 10R 1B 10TB 9TR 2R 3R 8TB 1B 12R 5B 6R 1TB 2B 7TB 2TR 11R 16B 13B 16R 7R 8B 5B 8TR 5R 6R 13R 10TR 13R 2R 11TB 12TB 7B 6TB 1TR 14TR 7TR",
+    "3TB 16R 15TR 6TB 13TB 4B 9TB 2B 11R 10B 5TR 2TR 5B 8TB 7TR 4B 1R 14TR 13B 6TB 7TB 12TR 9TR 16TR 15TB 16B 1TR 10B 1B 2B 11TB 10TB 3TR 4TR 5TB 8B 1TR 8TB 11TB 4B 3B 4B 9TR 14TR 15TR 6B 7B 12TR 13TB 10TB",
+    "1R 10TB 1TB 16TR 15TR 4TB 7B 12B 3TR 6B 1TR 16TR 13B 6TB 1TR 2TB 11B 8R 7R 12B 13TB 14TB 9R 16TB 1TB 2B 15B 2B 5B 4TR 11R 6B 3B 8B 11TR 12B 5TB 2TB 7TB 8TR 3B 12TB 9TR 10TB 11TR 2TB 7TR 2R 1B 12TR 15R 6TR 7TR",
+    "1TR 6B 13B 10TB 5R 10R 3R 8TB 3B 2R 15TR 12TR 15B 4TB 9B 2R 7TB 2TB 5TB 12B 3R 14R 9TR 16TR 11B 6B 3TR 8TR 11TR 14TB 9TB 6R 5TR 4TB 7R 16TB 13B 14B 15TR 12TR 1TR 8B 9R 10TR 13TR 16TB 7TR 14TR 5TB 10TR 11TB 4R 7B 4B 9R 6R",
+    "5TB 2B 11R 14R 1R 2R 7TB 4R 11TB 8R 1B 8B 11B 12TR 15TR 4TR 1TR 10TB 1B 14TB 1TR 6TB 3TR 4TR 15TR 6TR 3B 16B 15B 16B 13B 2B 5B 8R 7R 16B 1B 8TB 9TB 10TR 1B 14B 9R 14TR 11R 12TR 13R 4B 15R 16TB 1TR 12B 3B 14R 1B 4B 5B 16R 13TR",
+    "3R 2B 1TR 10TB 5B 14R 3B 4TR 3TR 16TB 7R 12TB 13TB 14TR 5TB 2R 3R 8TR 7TR 6TR 7TB 6B",
+    "13TR 6R 9TR 2TB 15B 4R 1R 10TR 3TB 4TB 1B 12TR 15TR 4R 7B 12B 11R 10B 7TB 8B 5R 6TB 13B 6R 1B",
+    "1R 2R 1B 10TB 11TB 4B 15TR 14R 1TR 8R 3TR 16B 13TB 2TB 13R 14TR 9TB 12B 15TR 16TB 5B 6TR 5TR 4B 7R 6TB 9TR 4TR",
+    "15TR 12B 3R 2R 1R 2R 1B 2B 9R 14TR 1TB 10B 13R 6R 9TR 16R 5R 8R 13B 10TR 5TB 4TB 9TB 6R 3TR 4TB 11R 12B 9R 2B 3B",
+    "1R 2R 7B 2B 1B 8B 1TR 12R 3R 2B 15R 14R 3B 2TR 11B 4R 3TR 14TR 7TR 4TR 5R 14R 9TR 12TB 15B 2B 5B 10TR 9B 8R 13TR 2R 5TR 6TB",
+    "1R 6R 1B 10TB 3TB 12TR 7R 8R 7B 2TR 3R 8TB 5TB 8TR 15TR 4TB 11TR 16R 5TR 12TR 1R 6TB 13TR 2TR 9TR 4TR 11TB 16TR 1TB 4TR 3TB 12B 3R 16B 13B 14TB 15TB",
+    "1R 2R 13B 2B 7B 14TR 1TB 6TB 11TB 16R 5TR 8R 3R 6R 5R 4R 9TB 16TB 13B 12TR 3TR 4B 7R 10TB 15TB 8R 7TB 4TR 9TR 14B 11R 8B 13R 14R 13B 8TB 3B 12B 13TB 10R",
+    "13B 2R 1R 2TB 9TB 4TR 11B 8B 1TR 14TR 15TR 16R 11TR 6B 5TR 12B 1B 12TR 7B 16TR 15TB 6TR 9TR 4TR 3R 6R 3B 4R 13TB 8TR 11TB 10TB 1TR 4B 7B 14TB 15R 4TR 1TR 16R 7B 8B 7TB",
+    "9R 10TR 3TB 14B 1TR 2R 1B 2B 3R 8TB 15TR 6TB 5R 12B 7B 6R 3R 4R 7TR 2R 5B 4B 5R 12TR 1R 8R 15TB 16R 9TR 16R 3R 14R 13R 10R 13TR 8TB 9TR 16TB 15B 6B 1TR 12TR 11R 14R 11TR 16TR",
+    "1R 2R 1B 2TB 13B 12R 15R 8R 7TR 6R 3R 4R 3B 4B 3TR 4TR 5R 6R 5B 6B 5TR 6TR 7R 8R 7B 8B 7TR 16R 11TR 10R 9TB 8B 13TB 12TB 5B 4TR 15TR 14TR 15TR 16TR 7TR 6TR 11B 8TR 1TR 12B 9TB 10TB 1B",
+    "9R 10TB 1R 2R 1B 14B 15TB 4TB 3R 2B 3B 6TB 7R 14R 13R 4B 9B 16TR 11B 10R 9R 8TB 11R 14R 5TB 12TR 9TR 4R 13TB 6B 9R 2TR 7TR 8B 3TR 6R 7R 8TR 7B 12R 5R 6TR 11R 12B 9TR 10TR 13TR 12TR 5B 10B 1B 6B",
+    "1R 2TB 15B 12TR 5R 8TR 1TB 2R 5B 4TB 5TR 2B 3B 4R 7TB 2TB 9TB 10TR 3TB 6R 3R 4TB 7B 14B 15TR 6R 11TR 14R 9R 2TR 13TB 2TR 3TR 8B 9B 12B 7R 8R 13R 6TB 5B 6B 9B 12TB 11R 14TB 1TR 16TB 5TR 2TB 9TB 6TR 7TB 12TR 11TB",
+    "1R 12TR 5TB 2R 1B 4TR 3TB 4TR 1TR 10TR 15TB 6B 9TR 6R 7B 14TB 7TR 8R 15R 2B 9TR 4B 1R 10B 15TR 16TR 13TB 8TR 1TB 16TB 11TB 2R 9TB 2TB 3TR 4TR 7R 10B 7TR 14R 15R 10TR 13TB 2R 11B 6TB 13TB 8TB 11B 6R 9TB 8R 11R 16R 3B 6B 15TB 14R",
+    "3R 8B 1R 14B 3TR 12TB 1TB 2R 5B 16TB 7R 6TB 3R 10TB 7TR 2B 5B 4TR 13TB 14R 5TB",
+    "5TR 14TR 15TR 6TB 3R 2R 5R 16B 1B 2B 1R 4R 9B 4B 1TB 2R 9R 2TR 3R 12TR 7B 12B 11TR 10R",
+    "1R 2R 1B 16TB 7TB 2B 11TB 12R 9R 10TR 5B 8TR 13TR 10TR 5TB 14R 5R 14TB 11B 4TB 1TB 6TB 7TR 8TR 9TR 12TR 15TR",
+    "1R 2R 1B 14R 11R 10TB 3R 8R 3B 16B 13B 12TR 5TB 4TR 5R 16TB 3TR 2B 15R 8B 5B 6TR 7R 4B 13TR 14TR 15B 6B 7TR 2B",
+    "7B 2R 13R 10TB 1TB 14R 15TR 12B 1TR 2R 9TB 16TR 7TB 14B 7R 12TB 5TB 4R 7R 6R 13TB 6TB 9TB 2B 11TR 2TR 5TB 8B 11B 4TR 7TB 4B 3TR",
+};
+#define CORPUS_SIZE ((int)(sizeof(corpus_moves) / sizeof(corpus_moves[0])))
+
+typedef struct {
+    GameState state;
+    Move moves[128];
+    int move_count;
+} BenchPosition;
+
+static BenchPosition corpus[CORPUS_SIZE];
+static int corpus_move_total;
+
+static int load_corpus(void) {
+    corpus_move_total = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        char buffer[1024];
+        snprintf(buffer, sizeof(buffer), "%s", corpus_moves[p]);
+
+        GameState *state = &corpus[p].state;
+        init_game_state(state);
+        for (char *tok = strtok(buffer, " "); tok; tok = strtok(NULL, " ")) {
+            Move move;
+            if (!parse_move(tok, &move) || !is_valid_move(state, &move)) {
+                fprintf(stderr, "Corpus : coup invalide %s (position %d)\n", tok, p);
+                return 0;
+            }
+            make_move(state, &move, NULL);
+        }
+        corpus[p].move_count = generate_legal_moves(state, corpus[p].moves);
+        corpus_move_total += corpus[p].move_count;
+    }
+    return 1;
+}
+
+/* ==== CHRONOMÉTRAGE ==== */
+
+static volatile uint64_t sink;   // Empêche le compilateur d'éliminer les appels
+
+static inline double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Une passe sur le corpus ; renvoie le nombre d'opérations effectuées
+typedef long (*BenchPass)(void);
+
+static long pass_execute_move(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        for (int i = 0; i < corpus[p].move_count; i++) {
+            GameState copy = corpus[p].state;
+            acc += execute_move(&copy, &corpus[p].moves[i]);
+        }
+    }
+    sink += acc;
+    return corpus_move_total;
+}
+
+// Hors ligne comme les fonctions du moteur : inlinée dans sa passe, elle
+// perdrait la copie et les écritures du plateau, que rien ne relit
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+// Semailles graine par graine puis captures trou par trou, comme le moteur
+// d'origine, sur le plateau actuel : la référence du noyau vectoriel
+static BENCH_NOINLINE int reference_move(GameState *state, const Move *move) {
+    int hole_index = move->hole_number - 1;
+    Color color = move->color;
+    int transparent = 0;
+    if (color == TRANSPARENT) {
+        color = move->transparent_color;
+        transparent = state->seeds[TRANSPARENT][hole_index];
+        state->seeds[TRANSPARENT][hole_index] = 0;
+    }
+    int seeds = state->seeds[color][hole_index];
+    state->seeds[color][hole_index] = 0;
+
+    // Rouge : trous suivants un par un ; Bleu : un sur deux, depuis le suivant
+    int step = (color == RED) ? 1 : 2;
+    int hole = hole_index, next = (hole_index + 1) % NUM_HOLES;
+    while (transparent + seeds > 0) {
+        if (next != hole_index) {
+            hole = next;
+            if (transparent > 0) {
+                state->seeds[TRANSPARENT][hole]++;
+                transparent--;
+            } else {
+                state->seeds[color][hole]++;
+                seeds--;
+            }
+        }
+        next = (next + step) % NUM_HOLES;
+    }
+
+    int captured = 0;
+    for (;;) {
+        int total = get_total_seeds_in_hole(state, hole);
+        if (total != 2 && total != 3) break;
+        captured += total;
+        for (int c = 0; c < NUM_COLORS; c++) state->seeds[c][hole] = 0;
+        hole = (hole + NUM_HOLES - 1) % NUM_HOLES;
+    }
+
+    state->captures[state->current_player] += captured;
+    state->current_player = 1 - state->current_player;
+    state->turn_number++;
+    return captured;
+}
+
+static long pass_reference_move(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        for (int i = 0; i < corpus[p].move_count; i++) {
+            GameState copy = corpus[p].state;
+            acc += reference_move(&copy, &corpus[p].moves[i]);
+        }
+    }
+    sink += acc;
+    return corpus_move_total;
+}
+
+// Noyau vectoriel sans clé ni agrégats (hormis le total) : comparable à reference_move
+static long pass_make_move_bare(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        for (int i = 0; i < corpus[p].move_count; i++) {
+            GameState copy = corpus[p].state;
+            acc += make_move_bare(&copy, &corpus[p].moves[i]);
+        }
+    }
+    sink += acc;
+    return corpus_move_total;
+}
+
+// Même question qu'execute_move (combien de graines ?), sans jouer le coup
+static long pass_capture_count(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        for (int i = 0; i < corpus[p].move_count; i++) {
+            acc += capture_count(&corpus[p].state, &corpus[p].moves[i]);
+        }
+    }
+    sink += acc;
+    return corpus_move_total;
+}
+
+// Tous les coups des deux joueurs d'une position
+static long pass_capture_potential(void) {
+    uint64_t acc = 0;
+    CapturePotential potential;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        capture_potential(&corpus[p].state, &potential);
+        acc += potential.best[PLAYER_1] + potential.best[PLAYER_2];
+    }
+    sink += acc;
+    return CORPUS_SIZE;
+}
+
+static long pass_make_unmake(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        GameState *state = &corpus[p].state;
+        for (int i = 0; i < corpus[p].move_count; i++) {
+            MoveUndo undo;
+            acc += make_move(state, &corpus[p].moves[i], &undo);
+            unmake_move(state, &undo);
+        }
+    }
+    sink += acc;
+    return corpus_move_total;
+}
+
+static long pass_generate_legal_moves(void) {
+    uint64_t acc = 0;
+    Move moves[128];
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        acc += generate_legal_moves(&corpus[p].state, moves);
+    }
+    sink += acc;
+    return CORPUS_SIZE;
+}
+
+static long pass_is_game_over(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        acc += is_game_over(&corpus[p].state);
+    }
+    sink += acc;
+    return CORPUS_SIZE;
+}
+
+static long pass_compute_hash(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        acc ^= compute_hash(&corpus[p].state);
+    }
+    sink += acc;
+    return CORPUS_SIZE;
+}
+
+static long pass_base_evaluate(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        const GameState *state = &corpus[p].state;
+        acc += base_evaluate(state, state->current_player);
+    }
+    sink += acc;
+    return CORPUS_SIZE;
+}
+
+static long pass_copy_game_state(void) {
+    uint64_t acc = 0;
+    GameState copy;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        copy_game_state(&corpus[p].state, &copy);
+        acc += copy.turn_number;
+    }
+    sink += acc;
+    return CORPUS_SIZE;
+}
+
+static SearchContext *bench_ctx;
+
+// Corpus plus petit que le cache : après la première passe, tout est en cache
+static long pass_cached_evaluate(void) {
+    uint64_t acc = 0;
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        const GameState *state = &corpus[p].state;
+        acc += cached_evaluate(bench_ctx, &bench_ctx->stats.eval_cache, state, state->current_player);
+    }
+    sink += acc;
+    return CORPUS_SIZE;
+}
+
+static long pass_order_moves(void) {
+    uint64_t acc = 0;
+    Move moves[128];
+    int scores[128];
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        memcpy(moves, corpus[p].moves, corpus[p].move_count * sizeof(Move));
+        order_moves(bench_ctx, &corpus[p].state, moves, corpus[p].move_count, scores, 0, NULL);
+        acc += moves[0].hole_number;
+    }
+    sink += acc;
+    return CORPUS_SIZE;
+}
+
+typedef struct {
+    const char *name;
+    BenchPass pass;
+    double median_ns, p95_ns;
+    long ops_per_rep;
+} Benchmark;
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_benchmark(Benchmark *b, int reps) {
+    // Nombre de passes par répétition pour environ TARGET_OPS opérations
+    long ops_per_pass = b->pass();
+    long passes = TARGET_OPS / (ops_per_pass > 0 ? ops_per_pass : 1);
+    if (passes < 1) passes = 1;
+
+    double samples[MAX_REPS];
+    for (int r = -WARMUP_REPS; r < reps; r++) {
+        long ops = 0;
+        double start = now_ns();
+        for (long k = 0; k < passes; k++) ops += b->pass();
+        double elapsed = now_ns() - start;
+        if (r >= 0) samples[r] = elapsed / ops;
+        b->ops_per_rep = ops;
+    }
+
+    qsort(samples, reps, sizeof(double), compare_double);
+    b->median_ns = samples[reps / 2];
+    b->p95_ns = samples[(int)((reps - 1) * 0.95 + 0.5)];
+}
+
+/* ==== PROGRAMME ==== */
+
+int main(int argc, char *argv[]) {
+    int reps = DEFAULT_REPS, csv = 0, json = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-reps") == 0 && i + 1 < argc) reps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-csv") == 0) csv = 1;
+        else if (strcmp(argv[i], "-json") == 0) json = 1;
+    }
+    if (reps < 1) reps = 1;
+    if (reps > MAX_REPS) reps = MAX_REPS;
+
+    if (!load_corpus()) return 1;
+    bench_ctx = search_create();
+    if (!bench_ctx) return 1;
+
+    Benchmark benches[] = {
+        { "reference_move",       pass_reference_move,       0, 0, 0 },
+        { "make_move_bare",       pass_make_move_bare,   0, 0, 0 },
+        { "execute_move",         pass_execute_move,         0, 0, 0 },
+        { "capture_count",        pass_capture_count,        0, 0, 0 },
+        { "capture_potential",    pass_capture_potential,    0, 0, 0 },
+        { "make_unmake_move",     pass_make_unmake,          0, 0, 0 },
+        { "generate_legal_moves", pass_generate_legal_moves, 0, 0, 0 },
+        { "is_game_over",         pass_is_game_over,         0, 0, 0 },
+        { "compute_hash",         pass_compute_hash,         0, 0, 0 },
+        { "base_evaluate",        pass_base_evaluate,        0, 0, 0 },
+        { "cached_evaluate",      pass_cached_evaluate,      0, 0, 0 },
+        { "copy_game_state",      pass_copy_game_state,      0, 0, 0 },
+        { "order_moves",          pass_order_moves,          0, 0, 0 },
+    };
+    int count = (int)(sizeof(benches) / sizeof(benches[0]));
+
+    for (int i = 0; i < count; i++) run_benchmark(&benches[i], reps);
+
+    if (json) {
+        printf("{\n  \"positions\": %d,\n  \"reps\": %d,\n  \"results\": [\n", CORPUS_SIZE, reps);
+        for (int i = 0; i < count; i++) {
+            printf("    {\"name\": \"%s\", \"median_ns\": %.2f, \"p95_ns\": %.2f, \"ops_per_rep\": %ld}%s\n",
+                   benches[i].name, benches[i].median_ns, benches[i].p95_ns, benches[i].ops_per_rep,
+                   i + 1 < count ? "," : "");
+        }
+        printf("  ]\n}\n");
+    } else if (csv) {
+        printf("name,median_ns,p95_ns,ops_per_rep\n");
+        for (int i = 0; i < count; i++) {
+            printf("%s,%.2f,%.2f,%ld\n", benches[i].name, benches[i].median_ns,
+                   benches[i].p95_ns, benches[i].ops_per_rep);
+        }
+    } else {
+        printf("=== BENCH === (%d positions, %d coups, %d répétitions)\n",
+               CORPUS_SIZE, corpus_move_total, reps);
+        printf("%-22s %12s %12s\n", "Fonction", "médiane ns", "p95 ns");
+        for (int i = 0; i < count; i++) {
+            printf("%-22s %12.2f %12.2f\n", benches[i].name, benches[i].median_ns, benches[i].p95_ns);
+        }
+    }
+
+    search_destroy(bench_ctx);
+    return 0;
+}
@@ -0,0 +1,274 @@
+//
+// build_book.c - Construction hors ligne du livre d'ouvertures
+//
+// Cherche en profondeur toutes les positions distinctes des premiers coups
+// depuis la position initiale, sur plusieurs threads, et écrit le livre trié.
+// Chaque résultat est ajouté au journal <livre>.log dès qu'il est connu :
+// relancer la commande reprend là où elle s'était arrêtée. Les positions déjà
+// présentes dans un livre existant sont aussi sautées, ce qui permet de
+// l'étendre à plus de coups.
+//
+// Usage : build_book [-plies n] [-time ms] [-depth d] [-j threads]
+//                    [-engine ia] [-hash MB] [-o livre]
+//   -plies   positions jusqu'à n demi-coups depuis la position initiale
+//   -time    temps de recherche par position
+//   -depth   profondeur maximale par position (0 = limitée par le temps)
+//   -j       threads de recherche (un contexte chacun)
+//   -engine  IA utilisée pour chercher (pvs par défaut, celle d'external_player)
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/book.h"
+#include "../include/game.h"
+#include "../include/match.h"
+#include "../include/player.h"
+#include "../include/tt.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_PLIES 2
+#define DEFAULT_TIME_MS 5000
+#define MAX_THREADS 64
+
+typedef struct {
+    GameState *positions;
+    int count;
+    atomic_int next;           // Prochaine position à chercher
+    atomic_int done;
+
+    const PlayerInfo *engine;
+    SearchLimits limits;
+
+    BookEntry *results;        // Entrées déjà connues puis nouvelles, sous lock
+    size_t result_count, result_cap;
+    FILE *journal;
+    pthread_mutex_t lock;
+} BookBuild;
+
+/* ==== POSITIONS ==== */
+
+static int compare_keys(const void *a, const void *b) {
+    uint64_t x = ((const GameState *)a)->hash, y = ((const GameState *)b)->hash;
+    return (x > y) - (x < y);
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Positions distinctes (par clé) jusqu'à plies demi-coups, niveau par niveau
+static GameState *enumerate_positions(int plies, int *count) {
+    size_t cap = 1, total = 1;
+    GameState *all = malloc(sizeof(GameState));
+    uint64_t *seen = malloc(sizeof(uint64_t));   // Clés des niveaux précédents, triées
+    if (!all || !seen) { free(all); free(seen); return NULL; }
+    init_game_state(&all[0]);
+    seen[0] = all[0].hash;
+
+    size_t level_start = 0, level_end = 1;
+    for (int ply = 0; ply < plies; ply++) {
+        for (size_t i = level_start; i < level_end; i++) {
+            if (is_game_over(&all[i])) continue;
+            Move moves[128];
+            int n = generate_legal_moves(&all[i], moves);
+            if (total + n > cap) {
+                while (total + n > cap) cap *= 2;
+                GameState *grown = realloc(all, cap * sizeof(GameState));
+                if (!grown) { free(all); free(seen); return NULL; }
+                all = grown;
+            }
+            for (int m = 0; m < n; m++) {
+                all[total] = all[i];
+                make_move(&all[total], &moves[m], NULL);
+                total++;
+            }
+        }
+
+        // Doublons du niveau (transpositions) et positions des niveaux précédents
+        qsort(all + level_end, total - level_end, sizeof(GameState), compare_keys);
+        size_t kept = level_end;
+        for (size_t i = level_end; i < total; i++) {
+            if (kept > level_end && all[kept - 1].hash == all[i].hash) continue;
+            if (bsearch(&all[i].hash, seen, level_end, sizeof(uint64_t), compare_u64)) continue;
+            all[kept++] = all[i];
+        }
+
+        // Clés du niveau gardé ajoutées à celles des niveaux précédents
+        uint64_t *grown = realloc(seen, (kept + 1) * sizeof(uint64_t));
+        if (!grown) { free(all); free(seen); return NULL; }
+        seen = grown;
+        for (size_t i = level_end; i < kept; i++) seen[i] = all[i].hash;
+        qsort(seen, kept, sizeof(uint64_t), compare_u64);
+        total = kept;
+        level_start = level_end;
+        level_end = total;
+    }
+
+    free(seen);
+    *count = (int)total;
+    return all;
+}
+
+/* ==== REPRISE ==== */
+
+static void add_result(BookBuild *b, const BookEntry *e) {
+    if (b->result_count == b->result_cap) {
+        size_t cap = b->result_cap ? b->result_cap * 2 : 1024;
+        BookEntry *grown = realloc(b->results, cap * sizeof(BookEntry));
+        if (!grown) return;
+        b->results = grown;
+        b->result_cap = cap;
+    }
+    b->results[b->result_count++] = *e;
+}
+
+static int compare_entry_keys(const void *a, const void *b) {
+    uint64_t x = ((const BookEntry *)a)->key, y = ((const BookEntry *)b)->key;
+    return (x > y) - (x < y);
+}
+
+// Résultats triés par load_previous, avant le lancement des threads
+static int known(const BookBuild *b, uint64_t key) {
+    BookEntry probe = { .key = key };
+    return b->result_count > 0
+        && bsearch(&probe, b->results, b->result_count, sizeof(BookEntry), compare_entry_keys) != NULL;
+}
+
+// Entrées d'un livre existant et du journal d'une construction interrompue
+static void load_previous(BookBuild *b, const char *path, const char *journal_path) {
+    Book book;
+    if (book_open(&book, path)) {
+        for (size_t i = 0; i < book.count; i++) add_result(b, &book.entries[i]);
+        book_close(&book);
+    }
+
+    FILE *f = fopen(journal_path, "rb");
+    if (f) {
+        BookEntry e;
+        while (fread(&e, sizeof(e), 1, f) == 1) add_result(b, &e);
+        fclose(f);
+    }
+    if (b->result_count > 0) qsort(b->results, b->result_count, sizeof(BookEntry), compare_entry_keys);
+}
+
+/* ==== RECHERCHE ==== */
+
+static void *worker_main(void *arg) {
+    BookBuild *b = arg;
+    Player ai = b->engine->create();
+    ai.ctx->limits = b->limits;
+
+    int i;
+    while ((i = atomic_fetch_add(&b->next, 1)) < b->count) {
+        const GameState *pos = &b->positions[i];
+
+        Move move;
+        ai.play(ai.ctx, pos, &move);
+
+        BookEntry e = {
+            .key = pos->hash,
+            .score = ai.ctx->stats.best_score,
+            .move = pack_move(&move),
+            .depth = (uint8_t)ai.ctx->stats.completed_depth,
+        };
+
+        pthread_mutex_lock(&b->lock);
+        add_result(b, &e);
+        fwrite(&e, sizeof(e), 1, b->journal);
+        fflush(b->journal);
+        int done = atomic_fetch_add(&b->done, 1) + 1;
+        const char *color = (move.color == TRANSPARENT)
+                          ? (move.transparent_color == RED ? "TR" : "TB")
+                          : (move.color == RED ? "R" : "B");
+        printf("[%d/%d] tour %d  %2d%-2s  depth=%d score=%d time=%ldms\n", done, b->count,
+               pos->turn_number, move.hole_number, color, e.depth, e.score, ai.ctx->stats.elapsed_ms);
+        pthread_mutex_unlock(&b->lock);
+    }
+
+    destroy_player(&ai);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    int plies = DEFAULT_PLIES, threads = match_default_workers();
+    const char *path = BOOK_DEFAULT_PATH, *engine = "pvs";
+    SearchLimits limits = { .max_time_ms = DEFAULT_TIME_MS };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-plies") == 0 && i + 1 < argc) plies = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-time") == 0 && i + 1 < argc) limits.max_time_ms = atol(argv[++i]);
+        else if (strcmp(argv[i], "-depth") == 0 && i + 1 < argc) limits.max_depth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-engine") == 0 && i + 1 < argc) engine = argv[++i];
+        else if (strcmp(argv[i], "-hash") == 0 && i + 1 < argc) tt_set_default_size_mb((size_t)atoi(argv[++i]));
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) path = argv[++i];
+    }
+    if (plies < 0) plies = 0;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    BookBuild b = { .limits = limits };
+    b.engine = find_player(engine);
+    Player probe = b.engine ? b.engine->create() : (Player){0};
+    int searches = probe.ctx != NULL;
+    if (b.engine) destroy_player(&probe);
+    if (!searches) {
+        fprintf(stderr, "IA de recherche inconnue ou sans contexte : %s\n", engine);
+        return 1;
+    }
+
+    int total;
+    GameState *all = enumerate_positions(plies, &total);
+    if (!all) {
+        fprintf(stderr, "Mémoire insuffisante pour %d demi-coups\n", plies);
+        return 1;
+    }
+
+    char journal_path[1024];
+    snprintf(journal_path, sizeof(journal_path), "%s.log", path);
+    load_previous(&b, path, journal_path);
+
+    // Ne garder que les positions à chercher
+    b.positions = all;
+    for (int i = 0; i < total; i++) {
+        if (!is_game_over(&all[i]) && !known(&b, all[i].hash)) all[b.count++] = all[i];
+    }
+    printf("=== LIVRE D'OUVERTURES === %d positions sur %d demi-coups, %d déjà connues, %d threads\n",
+           total, plies, total - b.count, threads);
+
+    b.journal = fopen(journal_path, "ab");
+    if (!b.journal) {
+        fprintf(stderr, "Impossible d'ouvrir le journal %s\n", journal_path);
+        return 1;
+    }
+    pthread_mutex_init(&b.lock, NULL);
+    atomic_init(&b.next, 0);
+    atomic_init(&b.done, 0);
+
+    pthread_t handles[MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < threads && t < b.count; t++) {
+        if (pthread_create(&handles[t], NULL, worker_main, &b) != 0) break;
+        started++;
+    }
+    if (started == 0 && b.count > 0) worker_main(&b);
+    for (int t = 0; t < started; t++) pthread_join(handles[t], NULL);
+    fclose(b.journal);
+
+    // Livre complet : le journal n'est plus utile
+    if (!book_write(path, b.results, b.result_count)) {
+        fprintf(stderr, "Écriture du livre %s impossible (journal conservé)\n", path);
+        return 1;
+    }
+    remove(journal_path);
+    printf("Livre écrit : %s\n", path);
+
+    pthread_mutex_destroy(&b.lock);
+    free(b.results);
+    free(all);
+    return 0;
+}
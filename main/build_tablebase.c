@@ -0,0 +1,513 @@
+//
+// build_tablebase.c - Construction de la table de finales par analyse rétrograde
+//
+// L'ensemble de toutes les positions à K graines est bien trop grand (plus de
+// 10^10 dès 10 graines réparties sur 48 cases), et même ce qu'on atteint depuis
+// une seule d'entre elles dépasse la mémoire : les semailles dispersent les
+// graines partout. La table couvre donc les finales qui se présentent
+// réellement. Des parties jouées par PVS à faible profondeur, après une
+// ouverture aléatoire, fournissent les premières positions à au plus K graines ;
+// on développe ensuite en largeur ce qu'on peut en atteindre, jusqu'à -max
+// positions. Les positions non développées forment la frontière.
+//
+// Valeur d'une position : marge de captures future du joueur au trait en jeu
+// parfait, une partie infinie (sans capture) comptant 0 comme la limite de tours.
+// Les coups sans capture gardent le nombre de graines et peuvent boucler : un
+// niveau (nombre de graines) se résout par seuils. Pour chaque seuil u, un jeu
+// d'attracteur dit si le joueur au trait peut s'assurer une marge >= u ; les
+// coups avec capture sortent vers les niveaux inférieurs, déjà résolus. Chaque
+// seuil est joué deux fois, frontière perdante puis gagnante pour l'attaquant :
+// on obtient un encadrement prouvé de la marge, et seules les positions dont
+// l'encadrement est réduit à une valeur sont écrites. Les seuils d'un niveau
+// sont indépendants et répartis entre les threads.
+//
+// Le rang des attracteurs borne la durée de toute ligne forcée : l'horizon de
+// la table (somme, niveau par niveau, du plus long gain forcé et de la sortie)
+// est écrit dans l'en-tête, et la table n'est sondée que si la partie dure
+// encore au moins autant.
+//
+// Usage : build_tablebase [-seeds K] [-games n] [-j threads] [-max n] [-s seed] [-o fichier]
+//   -seeds  graines sur le plateau au plus (niveaux 10..K)
+//   -games  parties jouées pour trouver les finales
+//   -max    nombre de positions développées au plus (mémoire : ~100 octets chacune)
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/game.h"
+#include "../include/match.h"
+#include "../include/player.h"
+#include "../include/tablebase.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_MAX_SEEDS 12
+#define DEFAULT_GAMES 200
+#define DEFAULT_MAX_POSITIONS 2000000
+#define ROOT_RANDOM_PLIES 10       // Ouverture aléatoire : des parties toutes différentes
+#define ROOT_SEARCH_DEPTH 3
+#define MIN_SEEDS 10               // En dessous, la partie est finie
+#define NO_EXIT (-128)             // Pas de coup avec capture
+#define MAX_THREADS 64
+
+/* ==== ENSEMBLE DE POSITIONS ==== */
+
+// Positions stockées à plat, retrouvées par board_key dans une table ouverte
+typedef struct {
+    GameState *states;
+    uint64_t *keys;
+    size_t count, cap, limit;
+    uint32_t *slots;           // Index + 1, 0 = vide
+    size_t mask;
+} PositionSet;
+
+static int set_init(PositionSet *set, size_t limit) {
+    memset(set, 0, sizeof(*set));
+    size_t slots = 1;
+    while (slots < 2 * limit) slots *= 2;
+    set->slots = calloc(slots, sizeof(uint32_t));
+    set->mask = slots - 1;
+    set->limit = limit;
+    return set->slots != NULL;
+}
+
+static void set_free(PositionSet *set) {
+    free(set->states);
+    free(set->keys);
+    free(set->slots);
+}
+
+static long set_find(const PositionSet *set, uint64_t key) {
+    for (size_t i = key & set->mask;; i = (i + 1) & set->mask) {
+        uint32_t idx = set->slots[i];
+        if (idx == 0) return -1;
+        if (set->keys[idx - 1] == key) return idx - 1;
+    }
+}
+
+// Ajoute la position si elle est nouvelle ; -1 si l'ensemble est plein
+static long set_add(PositionSet *set, const GameState *state) {
+    uint64_t key = board_key(state);
+    size_t i = key & set->mask;
+    for (; set->slots[i] != 0; i = (i + 1) & set->mask) {
+        if (set->keys[set->slots[i] - 1] == key) return set->slots[i] - 1;
+    }
+    if (set->count == set->limit) return -1;
+
+    if (set->count == set->cap) {
+        size_t cap = set->cap ? set->cap * 2 : 4096;
+        if (cap > set->limit) cap = set->limit;
+        GameState *states = realloc(set->states, cap * sizeof(GameState));
+        if (!states) return -1;
+        set->states = states;
+        uint64_t *keys = realloc(set->keys, cap * sizeof(uint64_t));
+        if (!keys) return -1;
+        set->keys = keys;
+        set->cap = cap;
+    }
+
+    // Les captures et le tour ne comptent pas : seul le plateau et le trait
+    GameState *s = &set->states[set->count];
+    *s = *state;
+    s->turn_number = 1;
+    set->keys[set->count] = key;
+    set->slots[i] = (uint32_t)++set->count;
+    return set->count - 1;
+}
+
+/* ==== POSITIONS DE DÉPART ET FERMETURE ==== */
+
+// Première position à au plus max_seeds graines de chaque partie
+static int collect_roots(PositionSet *set, int games, int max_seeds, unsigned int seed) {
+    const PlayerInfo *info = find_player("pvs");
+    Player ai = info->create();
+    ai.ctx->limits = (SearchLimits){ .max_depth = ROOT_SEARCH_DEPTH, .deterministic = 1 };
+
+    for (int g = 0; g < games; g++) {
+        srand(match_game_seed(seed, g));
+        GameState state;
+        init_game_state(&state);
+
+        for (int ply = 0; !is_game_over(&state); ply++) {
+            if (state.summary.total <= max_seeds) {
+                if (set_add(set, &state) < 0) {
+                    destroy_player(&ai);
+                    return 0;
+                }
+                break;
+            }
+
+            Move moves[128], move;
+            int n = generate_legal_moves(&state, moves);
+            if (n == 0) break;
+            if (ply < ROOT_RANDOM_PLIES) move = moves[rand() % n];
+            else ai.play(ai.ctx, &state, &move);
+            make_move(&state, &move, NULL);
+        }
+    }
+
+    destroy_player(&ai);
+    return 1;
+}
+
+// Développe en largeur depuis les positions de départ tant que l'ensemble peut
+// recevoir tous les enfants ; *expanded reçoit le nombre de positions développées
+// (les premières de l'ensemble, les suivantes forment la frontière).
+// 0 si la mémoire manque : un enfant absent fausserait la résolution
+static int expand_positions(PositionSet *set, size_t *expanded) {
+    size_t i = 0;
+    for (; i < set->count; i++) {
+        GameState state = set->states[i];
+        Move moves[128];
+        int n = generate_legal_moves(&state, moves);
+        if (set->count + n > set->limit) break;
+        for (int m = 0; m < n; m++) {
+            GameState child = state;
+            make_move(&child, &moves[m], NULL);
+            if (child.summary.total < MIN_SEEDS) continue;
+            if (set_add(set, &child) < 0) return 0;
+        }
+    }
+    *expanded = i;
+    return 1;
+}
+
+/* ==== RÉSOLUTION D'UN NIVEAU ==== */
+
+// Graphe d'un niveau : positions à n graines, indices locaux
+typedef struct {
+    int count;
+    uint8_t *frontier;         // Non développée : statut inconnu
+    int8_t *exit_lo, *exit_hi; // Encadrement de la meilleure sortie par capture, NO_EXIT sinon
+    uint8_t *has_moves;
+    int *succ_count;           // Coups sans capture (vers le même niveau)
+    int *pred_start, *preds;   // Prédécesseurs par coup sans capture, avec multiplicité
+
+    // Résultats fusionnés des seuils, sous lock. Passe P : frontière perdante
+    // pour l'attaquant ; passe O : frontière gagnante
+    int8_t *attack_p, *attack_o;     // Plus grand u gagné en attaque (0 : aucun)
+    int8_t *defense_p, *defense_o;   // Plus petit u tenu en défense
+    int max_plies;                   // Plus long gain forcé dans le niveau (demi-coups)
+    pthread_mutex_t lock;
+    atomic_int next_threshold;
+    int max_threshold;
+} Level;
+
+// Jeu d'attracteur pour le seuil u : l'attaquant (au trait, il lui faut >= u)
+// gagne s'il atteint une sortie >= u ; le défenseur (il lui faut >= 1 - u) gagne
+// sur une sortie >= 1 - u, faute de coup (marge 0) ou en faisant durer la partie.
+// optimistic : frontière et sorties incertaines comptées pour l'attaquant.
+// Renvoie le plus grand rang de l'attracteur : demi-coups qu'il faut au plus
+// au gagnant pour atteindre sa sortie (plies : rang de chaque nœud)
+static int solve_threshold(const Level *lv, int u, int optimistic,
+                           uint8_t *win_a, uint8_t *win_d, int *remaining, int *queue, int *plies) {
+    int n = lv->count, head = 0, tail = 0, longest = 0;
+
+    for (int p = 0; p < n; p++) {
+        int attack_exit = optimistic ? lv->exit_hi[p] : lv->exit_lo[p];
+        int defense_exit = optimistic ? lv->exit_lo[p] : lv->exit_hi[p];
+
+        if (lv->frontier[p]) {
+            win_a[p] = optimistic;
+            remaining[p] = -1;
+            win_d[p] = optimistic;
+        } else {
+            win_a[p] = attack_exit != NO_EXIT && attack_exit >= u;
+            int blocked = !lv->has_moves[p] || (defense_exit != NO_EXIT && defense_exit >= 1 - u);
+            remaining[p] = blocked ? -1 : lv->succ_count[p];
+            win_d[p] = remaining[p] == 0;
+        }
+        if (win_a[p]) plies[queue[tail++] = 2 * p] = 0;
+        if (win_d[p]) plies[queue[tail++] = 2 * p + 1] = 0;
+    }
+
+    // Parcours en largeur : un nœud prend le rang de celui qui le décide, plus un
+    while (head < tail) {
+        int node = queue[head++];
+        int q = node / 2, rank = plies[node] + 1;
+        for (int i = lv->pred_start[q]; i < lv->pred_start[q + 1]; i++) {
+            int p = lv->preds[i];
+            if (node % 2 == 0) {
+                // Attaquant gagnant en q : le défenseur en p perd ce coup
+                if (remaining[p] > 0 && --remaining[p] == 0) {
+                    win_d[p] = 1;
+                    plies[queue[tail++] = 2 * p + 1] = rank;
+                    if (rank > longest) longest = rank;
+                }
+            } else if (!win_a[p]) {
+                // Défenseur perdant en q : l'attaquant en p y joue
+                win_a[p] = 1;
+                plies[queue[tail++] = 2 * p] = rank;
+                if (rank > longest) longest = rank;
+            }
+        }
+    }
+    return longest;
+}
+
+static void *threshold_worker(void *arg) {
+    Level *lv = arg;
+    int n = lv->count;
+    uint8_t *win_a = malloc(n), *win_d = malloc(n);
+    int *remaining = malloc(n * sizeof(int)), *queue = malloc(2 * (size_t)n * sizeof(int));
+    int *plies = malloc(2 * (size_t)n * sizeof(int));
+    if (!win_a || !win_d || !remaining || !queue || !plies) {
+        fprintf(stderr, "Mémoire insuffisante pour un seuil\n");
+        exit(1);
+    }
+
+    int u;
+    while ((u = atomic_fetch_add(&lv->next_threshold, 1)) <= lv->max_threshold) {
+        for (int optimistic = 0; optimistic <= 1; optimistic++) {
+            int longest = solve_threshold(lv, u, optimistic, win_a, win_d, remaining, queue, plies);
+
+            // win_d marque les défenses perdues : défense tenue = !win_d
+            int8_t *attack = optimistic ? lv->attack_o : lv->attack_p;
+            int8_t *defense = optimistic ? lv->defense_o : lv->defense_p;
+            pthread_mutex_lock(&lv->lock);
+            if (longest > lv->max_plies) lv->max_plies = longest;
+            for (int p = 0; p < n; p++) {
+                if (win_a[p] && u > attack[p]) attack[p] = (int8_t)u;
+                if (!win_d[p] && u < defense[p]) defense[p] = (int8_t)u;
+            }
+            pthread_mutex_unlock(&lv->lock);
+        }
+    }
+
+    free(win_a);
+    free(win_d);
+    free(remaining);
+    free(queue);
+    free(plies);
+    return NULL;
+}
+
+// Marge garantie d'après les seuils : plus grand u gagné en attaque, sinon
+// 1 - plus petit u tenu en défense
+static int8_t threshold_margin(int8_t attack, int8_t defense, int seeds) {
+    int margin = attack > 0 ? attack : 1 - defense;
+    if (margin > seeds) margin = seeds;
+    if (margin < -seeds) margin = -seeds;
+    return (int8_t)margin;
+}
+
+// Encadre les positions à seeds graines dans [lo, hi] ; les niveaux inférieurs
+// sont déjà encadrés. expanded : nombre de positions développées. horizon :
+// demi-coups suffisant à réaliser les marges des niveaux inférieurs, étendu à
+// celui-ci (plus long gain forcé, la sortie, puis l'horizon en dessous)
+static int solve_level(const PositionSet *set, size_t expanded, int8_t *lo, int8_t *hi, int seeds, int threads,
+                       int *horizon) {
+    int n = 0;
+    for (size_t i = 0; i < set->count; i++) n += set->states[i].summary.total == seeds;
+    if (n == 0) return 1;
+
+    int *global = malloc(n * sizeof(int));
+    int *local = malloc(set->count * sizeof(int));
+    Level lv = { .count = n };
+    lv.frontier = malloc(n);
+    lv.exit_lo = malloc(n);
+    lv.exit_hi = malloc(n);
+    lv.has_moves = malloc(n);
+    lv.succ_count = calloc(n + 1, sizeof(int));
+    lv.pred_start = calloc(n + 2, sizeof(int));
+    lv.attack_p = calloc(n, 1);
+    lv.attack_o = calloc(n, 1);
+    lv.defense_p = malloc(n);
+    lv.defense_o = malloc(n);
+    if (!global || !local || !lv.frontier || !lv.exit_lo || !lv.exit_hi || !lv.has_moves || !lv.succ_count
+        || !lv.pred_start || !lv.attack_p || !lv.attack_o || !lv.defense_p || !lv.defense_o) return 0;
+
+    for (size_t i = 0, k = 0; i < set->count; i++) {
+        if (set->states[i].summary.total == seeds) {
+            local[i] = (int)k;
+            global[k++] = (int)i;
+        }
+    }
+
+    // Deux passes sur les coups : compter les prédécesseurs, puis les ranger
+    size_t edges = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        int *fill = pass ? calloc(n, sizeof(int)) : NULL;
+        if (pass && (!fill || !(lv.preds = malloc((edges + 1) * sizeof(int))))) return 0;
+
+        for (int p = 0; p < n; p++) {
+            lv.frontier[p] = (size_t)global[p] >= expanded;
+            lv.exit_lo[p] = lv.exit_hi[p] = NO_EXIT;
+            lv.has_moves[p] = 1;
+            if (lv.frontier[p]) continue;
+
+            GameState state = set->states[global[p]];
+            Move moves[128];
+            int count = generate_legal_moves(&state, moves);
+            int best_lo = NO_EXIT, best_hi = NO_EXIT;
+            for (int m = 0; m < count; m++) {
+                GameState child = state;
+                int captured = make_move(&child, &moves[m], NULL);
+                int total = child.summary.total;
+                long c = total >= MIN_SEEDS ? set_find(set, board_key(&child)) : -1;
+
+                // Enfant absent de l'ensemble (ne devrait pas arriver, voir
+                // expand_positions) : sortie de valeur inconnue, encadrée
+                // par les graines restantes, comme une frontière
+                if (captured > 0 || c < 0) {
+                    int rest_lo = 0, rest_hi = 0;
+                    if (total >= MIN_SEEDS) {
+                        rest_lo = c >= 0 ? lo[c] : -total;
+                        rest_hi = c >= 0 ? hi[c] : total;
+                    }
+                    if (captured - rest_hi > best_lo) best_lo = captured - rest_hi;
+                    if (captured - rest_lo > best_hi) best_hi = captured - rest_lo;
+                    continue;
+                }
+                int q = local[c];
+                if (pass == 0) {
+                    lv.pred_start[q + 1]++;
+                    lv.succ_count[p]++;
+                    edges++;
+                } else {
+                    lv.preds[lv.pred_start[q] + fill[q]++] = p;
+                }
+            }
+            lv.exit_lo[p] = (int8_t)best_lo;
+            lv.exit_hi[p] = (int8_t)best_hi;
+            lv.has_moves[p] = count > 0;
+        }
+
+        if (pass == 0) {
+            for (int q = 0; q < n; q++) lv.pred_start[q + 1] += lv.pred_start[q];
+        }
+        free(fill);
+    }
+
+    // Seuils 1..seeds+1 : la marge future est comprise entre -seeds et seeds
+    memset(lv.defense_p, seeds + 1, n);
+    memset(lv.defense_o, seeds + 1, n);
+    lv.max_threshold = seeds + 1;
+    atomic_init(&lv.next_threshold, 1);
+    pthread_mutex_init(&lv.lock, NULL);
+
+    pthread_t handles[MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < threads && t < lv.max_threshold; t++) {
+        if (pthread_create(&handles[t], NULL, threshold_worker, &lv) != 0) break;
+        started++;
+    }
+    if (started == 0) threshold_worker(&lv);
+    for (int t = 0; t < started; t++) pthread_join(handles[t], NULL);
+    pthread_mutex_destroy(&lv.lock);
+    *horizon += lv.max_plies + 1;
+
+    // Garanti même frontière perdante : borne basse ; possible frontière gagnante : borne haute
+    for (int p = 0; p < n; p++) {
+        lo[global[p]] = threshold_margin(lv.attack_p[p], lv.defense_o[p], seeds);
+        hi[global[p]] = threshold_margin(lv.attack_o[p], lv.defense_p[p], seeds);
+    }
+
+    free(global);
+    free(local);
+    free(lv.frontier);
+    free(lv.exit_lo);
+    free(lv.exit_hi);
+    free(lv.has_moves);
+    free(lv.succ_count);
+    free(lv.pred_start);
+    free(lv.preds);
+    free(lv.attack_p);
+    free(lv.attack_o);
+    free(lv.defense_p);
+    free(lv.defense_o);
+    return 1;
+}
+
+static double seconds_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    int max_seeds = DEFAULT_MAX_SEEDS, games = DEFAULT_GAMES, threads = match_default_workers();
+    long max_positions = DEFAULT_MAX_POSITIONS;
+    unsigned int seed = 1;
+    const char *path = TB_DEFAULT_PATH;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-seeds") == 0 && i + 1 < argc) max_seeds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-games") == 0 && i + 1 < argc) games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-max") == 0 && i + 1 < argc) max_positions = atol(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) path = argv[++i];
+    }
+    if (max_seeds < MIN_SEEDS) max_seeds = MIN_SEEDS;
+    if (max_seeds > 60) max_seeds = 60;   // Marges sur int8 ; bien au-delà de ce qui tient en mémoire
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    PositionSet set;
+    if (max_positions < 1 || !set_init(&set, (size_t)max_positions)) {
+        fprintf(stderr, "Mémoire insuffisante pour %ld positions\n", max_positions);
+        return 1;
+    }
+
+    printf("=== TABLE DE FINALES === %d graines au plus, %d parties, %d threads\n", max_seeds, games, threads);
+    if (!collect_roots(&set, games, max_seeds, seed)) {
+        fprintf(stderr, "Plus de %ld positions de départ : réduire -games ou augmenter -max\n", max_positions);
+        return 1;
+    }
+    size_t roots = set.count;
+    size_t expanded;
+    if (!expand_positions(&set, &expanded)) {
+        fprintf(stderr, "Mémoire insuffisante pendant le développement des positions\n");
+        return 1;
+    }
+    printf("Positions : %zu départs, %zu développées, %zu en frontière (%.1fs)\n",
+           roots, expanded, set.count - expanded, seconds_since(&start));
+
+    int8_t *lo = calloc(set.count + 1, 1), *hi = calloc(set.count + 1, 1);
+    if (!lo || !hi) return 1;
+    int horizon = 0;
+    for (int seeds = MIN_SEEDS; seeds <= max_seeds; seeds++) {
+        if (!solve_level(&set, expanded, lo, hi, seeds, threads, &horizon)) {
+            fprintf(stderr, "Mémoire insuffisante pour le niveau %d\n", seeds);
+            return 1;
+        }
+
+        long level = 0, exact = 0, wins = 0, losses = 0;
+        for (size_t i = 0; i < set.count; i++) {
+            if (set.states[i].summary.total != seeds) continue;
+            level++;
+            if (lo[i] != hi[i]) continue;
+            exact++;
+            wins += lo[i] > 0;
+            losses += lo[i] < 0;
+        }
+        printf("  %2d graines : %8ld positions  %8ld exactes  marge >0 %5.1f%%  <0 %5.1f%%  horizon %3d  (%.1fs)\n",
+               seeds, level, exact, exact ? 100.0 * wins / exact : 0.0, exact ? 100.0 * losses / exact : 0.0,
+               horizon, seconds_since(&start));
+    }
+
+    // Seules les valeurs prouvées sont écrites
+    size_t kept = 0;
+    for (size_t i = 0; i < set.count; i++) {
+        if (lo[i] != hi[i]) continue;
+        set.keys[kept] = set.keys[i];
+        lo[kept++] = lo[i];
+    }
+    if (!tb_write(path, max_seeds, horizon, set.keys, lo, kept)) {
+        fprintf(stderr, "Écriture de %s impossible\n", path);
+        return 1;
+    }
+    printf("Table écrite : %s (%zu positions exactes, horizon %d demi-coups)\n", path, kept, horizon);
+
+    free(lo);
+    free(hi);
+    set_free(&set);
+    return 0;
+}
@@ -0,0 +1,218 @@
+//
+// convert_games.c - Conversion des journaux texte de parties en fichier binaire (gamelog)
+//
+// Lit les sorties de l'arbitre Java (« A -> 13R », « B -> RESULT 4TB 30 21 »,
+// « RESULT Joueur A disqualifié (timeout) », « Fin. ») et le format de
+// replay_game (« 12:A -> 13R »). Plusieurs parties peuvent se suivre dans un
+// même journal : une partie se termine sur « Fin. », sur un résultat, ou quand
+// un nouveau coup numéro 1 apparaît. Chaque coup est rejoué et vérifié ; une
+// partie avec un coup illégal est écartée.
+//
+// Usage : convert_games [-a nomA] [-b nomB] [-time ms] [-o fichier] [journal ...]
+//   sans journal, lit l'entrée standard
+//
+#include "../include/gamelog.h"
+#include "../include/game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_OUTPUT "games.bin"
+#define DEFAULT_TIME_MS 3000       // Délai de l'arbitre par coup
+#define MAX_GAME_MOVES 1024
+
+typedef struct {
+    GameLogGame header;            // Noms et cadence communs, le reste par partie
+    GameState state;
+    uint8_t moves[MAX_GAME_MOVES];
+    int move_count;
+    int active;                    // Au moins une ligne de la partie lue
+    int invalid;                   // Coup illégal ou illisible : partie écartée
+    int finished;                  // Résultat lu, on attend la partie suivante
+    int disqualified;              // Joueur disqualifié (PlayerIndex), -1 sinon
+    long line;                     // Première ligne de la partie, pour les messages
+} Conversion;
+
+typedef struct {
+    long games, skipped, moves;
+} ConversionStats;
+
+/* ==== PARTIES ==== */
+
+static void start_game(Conversion *c, long line) {
+    init_game_state(&c->state);
+    c->move_count = 0;
+    c->active = 1;
+    c->invalid = 0;
+    c->finished = 0;
+    c->disqualified = -1;
+    c->line = line;
+}
+
+static void finish_game(Conversion *c, GameLogWriter *w, ConversionStats *stats, const char *source) {
+    if (!c->active) return;
+    c->active = 0;
+
+    if (c->invalid || c->move_count == 0) {
+        if (c->invalid) fprintf(stderr, "%s:%ld : partie écartée (coup illégal ou illisible)\n", source, c->line);
+        stats->skipped++;
+        return;
+    }
+
+    GameLogGame game = c->header;
+    const GameState *s = &c->state;
+    game.move_count = (uint16_t)c->move_count;
+    game.captures[0] = s->captures[PLAYER_1];
+    game.captures[1] = s->captures[PLAYER_2];
+
+    if (c->disqualified >= 0) {
+        game.end = GAMELOG_END_DISQUALIFIED;
+        game.winner = (int8_t)(1 - c->disqualified);
+    } else if (is_game_over(s)) {
+        game.end = GAMELOG_END_NORMAL;
+        game.winner = s->captures[PLAYER_1] == s->captures[PLAYER_2] ? GAMELOG_DRAW
+                    : s->captures[PLAYER_1] > s->captures[PLAYER_2] ? PLAYER_1 : PLAYER_2;
+    } else {
+        game.end = GAMELOG_END_UNFINISHED;
+        game.winner = GAMELOG_UNKNOWN;
+    }
+
+    if (!gamelog_writer_add(w, &game, c->moves)) {
+        fprintf(stderr, "Écriture de la partie impossible\n");
+        exit(1);
+    }
+    stats->games++;
+    stats->moves += c->move_count;
+}
+
+// Coup texte (13R, 4TB) : parse_move après contrôle de la forme
+static int read_move(const char *token, Move *move) {
+    char buf[8];
+    size_t digits = strspn(token, "0123456789");
+    size_t len = strcspn(token, " \t\r\n");
+    if (digits == 0 || digits > 2 || len > 4 || len <= digits) return 0;
+    memcpy(buf, token, len);
+    buf[len] = '\0';
+    return parse_move(buf, move);
+}
+
+static void play_move(Conversion *c, PlayerIndex player, const char *token) {
+    Move move;
+    if (c->invalid) return;
+    if (!read_move(token, &move) || c->state.current_player != player
+        || c->move_count == MAX_GAME_MOVES || is_game_over(&c->state)) {
+        c->invalid = 1;
+        return;
+    }
+
+    Move legal[128];
+    int n = generate_legal_moves(&c->state, legal);
+    uint8_t packed = pack_move(&move);
+    for (int i = 0; i < n; i++) {
+        if (pack_move(&legal[i]) == packed) {
+            make_move(&c->state, &legal[i], NULL);
+            c->moves[c->move_count++] = packed;
+            return;
+        }
+    }
+    c->invalid = 1;
+}
+
+/* ==== LECTURE DES JOURNAUX ==== */
+
+static void convert_stream(FILE *in, const char *source, Conversion *c, GameLogWriter *w, ConversionStats *stats) {
+    char line[512];
+    long line_number = 0;
+
+    while (fgets(line, sizeof(line), in)) {
+        line_number++;
+        char *p = line;
+        while (*p == ' ' || *p == '\t') p++;
+
+        if (strncmp(p, "Fin.", 4) == 0) {
+            finish_game(c, w, stats, source);
+            continue;
+        }
+
+        // « RESULT Joueur A disqualifié (...) » ; « RESULT LIMIT » n'arrête pas l'arbitre
+        if (strncmp(p, "RESULT Joueur ", 14) == 0 && (p[14] == 'A' || p[14] == 'B')) {
+            if (!c->active) start_game(c, line_number);
+            c->disqualified = p[14] == 'A' ? PLAYER_1 : PLAYER_2;
+            c->finished = 1;
+            continue;
+        }
+
+        // « [n:]A -> coup »
+        int number = 0;
+        char *colon = strchr(p, ':');
+        char *arrow = strstr(p, "->");
+        if (!arrow) continue;
+        if (colon && colon < arrow) {
+            number = atoi(p);
+            p = colon + 1;
+            while (*p == ' ') p++;
+        }
+        char *q = p + 1;
+        while (*q == ' ') q++;
+        if ((*p != 'A' && *p != 'B') || q != arrow) continue;
+        PlayerIndex player = *p == 'A' ? PLAYER_1 : PLAYER_2;
+
+        char *token = arrow + 2;
+        while (*token == ' ') token++;
+        int result = strncmp(token, "RESULT ", 7) == 0;
+        if (result) token += 7;
+
+        if (c->active && (c->finished || number == 1)) finish_game(c, w, stats, source);
+        if (!c->active) start_game(c, line_number);
+
+        play_move(c, player, token);
+        if (result) c->finished = 1;
+    }
+    finish_game(c, w, stats, source);
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = DEFAULT_OUTPUT, *names[2] = { "A", "B" };
+    long time_ms = DEFAULT_TIME_MS;
+    const char *inputs[256];
+    int input_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) names[0] = argv[++i];
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) names[1] = argv[++i];
+        else if (strcmp(argv[i], "-time") == 0 && i + 1 < argc) time_ms = atol(argv[++i]);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) path = argv[++i];
+        else if (input_count < 256) inputs[input_count++] = argv[i];
+    }
+
+    Conversion c = {0};
+    for (int p = 0; p < 2; p++) {
+        strncpy(c.header.players[p], names[p], GAMELOG_NAME_SIZE - 1);
+    }
+    c.header.time_ms = time_ms > 0 ? (uint32_t)time_ms : 0;
+
+    GameLogWriter w;
+    if (!gamelog_writer_open(&w, path)) {
+        fprintf(stderr, "Impossible d'écrire %s.tmp\n", path);
+        return 1;
+    }
+
+    ConversionStats stats = {0};
+    if (input_count == 0) convert_stream(stdin, "stdin", &c, &w, &stats);
+    for (int i = 0; i < input_count; i++) {
+        FILE *in = fopen(inputs[i], "r");
+        if (!in) {
+            fprintf(stderr, "Impossible de lire %s\n", inputs[i]);
+            continue;
+        }
+        convert_stream(in, inputs[i], &c, &w, &stats);
+        fclose(in);
+    }
+
+    if (!gamelog_writer_close(&w)) {
+        fprintf(stderr, "Écriture de %s impossible\n", path);
+        return 1;
+    }
+    printf("%s : %ld parties, %ld coups, %ld parties écartées\n", path, stats.games, stats.moves, stats.skipped);
+    return 0;
+}
@@ -3,13 +3,22 @@
  * Programme pour jouer via stdin/stdout avec l'arbitre Java
  */
 
+#include "../include/ai_common.h"
+#include "../include/book.h"
 #include "../include/game.h"
 #include "../include/player.h"
+#include "../include/tablebase.h"
+#include "../include/tt.h"
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+// L'arbitre Java disqualifie un joueur qui met plus de 3 s (temps réel) à répondre
+#define ARBITER_TIMEOUT_MS 3000
+#define DEFAULT_SAFETY_MARGIN_MS 300
+
 #ifdef _WIN32
     #include <process.h>
     #define getpid _getpid
@@ -49,6 +58,65 @@ void send_result(const Move* move, const GameState* state) {
     fflush(stdout);
 }
 
+/* ==== RÉFLEXION ANTICIPÉE ==== */
+
+// Recherche lancée pendant le tour adverse, sur la position qui suit sa réponse prévue
+typedef struct {
+    Player *ai;
+    GameState pos;
+    uint8_t predicted;     // Réponse prévue (pack_move)
+    Move result;
+    pthread_t handle;
+    int active;
+} Ponder;
+
+static void *ponder_main(void *arg) {
+    Ponder *p = arg;
+    p->ai->play(p->ai->ctx, &p->pos, &p->result);
+    return NULL;
+}
+
+// Réponse prévue : le coup de la table pour la position après notre coup,
+// c'est-à-dire le deuxième coup de la variation principale. Inutile si la
+// position qui suit est dans le livre
+static void start_ponder(Ponder *p, Player *ai, const Book *book, const GameState *state) {
+    p->active = 0;
+    TTEntry e;
+    if (!tt_probe(&ai->ctx->tt, state->hash, &e) || e.move == MOVE_NONE) return;
+
+    Move reply = unpack_move(e.move);
+    Move legal[128];
+    int n = generate_legal_moves(state, legal);
+    int found = 0;
+    for (int i = 0; i < n && !found; i++) found = pack_move(&legal[i]) == e.move;
+    if (!found) return;
+
+    p->ai = ai;
+    p->pos = *state;
+    make_move(&p->pos, &reply, NULL);
+    Move book_reply;
+    if (is_game_over(&p->pos) || book_move(book, &p->pos, &book_reply)) return;
+    p->predicted = e.move;
+
+    search_ponder(ai->ctx);
+    p->active = pthread_create(&p->handle, NULL, ponder_main, p) == 0;
+}
+
+// L'adversaire a joué : renvoie 1 et notre coup si la prévision était bonne,
+// la recherche continue alors avec le budget normal depuis la profondeur atteinte
+static int finish_ponder(Ponder *p, const Move *opponent_move, Move *our_move) {
+    if (!p->active) return 0;
+    p->active = 0;
+
+    int hit = pack_move(opponent_move) == p->predicted;
+    if (hit) search_ponderhit(p->ai->ctx);
+    else search_abort(p->ai->ctx);
+    pthread_join(p->handle, NULL);
+
+    if (hit) *our_move = p->result;
+    return hit;
+}
+
 int main(int argc, char* argv[]) {
     unsigned int seed = (unsigned int)(time(NULL) + getpid());
     srand(seed);
@@ -60,10 +128,43 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // Taille optionnelle de la table de transposition (Mo) : external_player B 64
+    // La table est conservée d'un coup à l'autre, les entrées anciennes vieillissent
+    if (argc > 2) {
+        int hash_mb = atoi(argv[2]);
+        if (hash_mb > 0) tt_set_default_size_mb((size_t)hash_mb);
+    }
+
     GameState state;
     init_game_state(&state);
 
-    Player our_ai = create_ai_pvs_player();
+    // Nombre de threads optionnel : external_player B 64 4
+    // Seul PVS v2 sait chercher en parallèle (Lazy SMP), on le prend dans ce cas
+    int search_threads = (argc > 3) ? atoi(argv[3]) : 1;
+
+    Player our_ai = (search_threads > 1) ? create_ai_pvs_v2_player() : create_ai_pvs_player();
+    our_ai.ctx->num_threads = search_threads;
+
+    // Marge de sécurité optionnelle (ms) : external_player B 64 4 500
+    // Le budget par coup est le délai de l'arbitre moins cette marge ; le temps
+    // économisé sur les coups faciles est mis en banque pour les suivants
+    long margin_ms = (argc > 4) ? atol(argv[4]) : DEFAULT_SAFETY_MARGIN_MS;
+    if (margin_ms < 0 || margin_ms >= ARBITER_TIMEOUT_MS) margin_ms = DEFAULT_SAFETY_MARGIN_MS;
+    our_ai.ctx->limits.max_time_ms = ARBITER_TIMEOUT_MS - margin_ms;
+
+    // Réflexion pendant le tour adverse, désactivable : external_player B 64 4 500 0
+    int pondering = (argc > 5) ? atoi(argv[5]) != 0 : 1;
+    Ponder ponder = {0};
+
+    // Livre d'ouvertures optionnel (make book) : external_player B 64 4 500 1 book.bin
+    // Un coup du livre est joué sans recherche et son temps est mis en banque
+    Book book;
+    book_open(&book, (argc > 6) ? argv[6] : BOOK_DEFAULT_PATH);
+
+    // Table de finales optionnelle (make tablebase) : external_player B 64 4 500 1 book.bin endgame.tb
+    // La recherche y lit le résultat exact des positions à peu de graines
+    Tablebase tablebase;
+    if (tb_open(&tablebase, (argc > 7) ? argv[7] : TB_DEFAULT_PATH)) our_ai.ctx->tablebase = &tablebase;
 
     char input_line[256];
 
@@ -73,11 +174,13 @@ int main(int argc, char* argv[]) {
         if (strcmp(input_line, "START") == 0) {
             if (our_player == PLAYER_1) {
                 Move our_move;
-                our_ai.play(&state, &our_move);
+                if (book_move(&book, &state, &our_move)) {
+                    search_bank_move(our_ai.ctx, TIME_LIMIT_MS);
+                } else {
+                    our_ai.play(our_ai.ctx, &state, &our_move);
+                }
 
-                state.captures[state.current_player] += execute_move(&state, &our_move);
-                state.current_player = (state.current_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
-                state.turn_number++;
+                make_move(&state, &our_move, NULL);
 
                 if (is_game_over(&state)) {
                     send_result(&our_move, &state);
@@ -85,6 +188,7 @@ int main(int argc, char* argv[]) {
                 }
 
                 send_move(&our_move);
+                if (pondering) start_ponder(&ponder, &our_ai, &book, &state);
             }
             continue;
         }
@@ -95,18 +199,22 @@ int main(int argc, char* argv[]) {
 
         Move opponent_move;
         if (parse_move(input_line, &opponent_move)) {
+            int ponder_hit = 0;
+            Move our_move;
             if (state.current_player != our_player) {
-                state.captures[state.current_player] += execute_move(&state, &opponent_move);
-                state.current_player = (state.current_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
-                state.turn_number++;
+                ponder_hit = finish_ponder(&ponder, &opponent_move, &our_move);
+                make_move(&state, &opponent_move, NULL);
             }
 
-            Move our_move;
-            our_ai.play(&state, &our_move);
+            if (!ponder_hit) {
+                if (book_move(&book, &state, &our_move)) {
+                    search_bank_move(our_ai.ctx, TIME_LIMIT_MS);
+                } else {
+                    our_ai.play(our_ai.ctx, &state, &our_move);
+                }
+            }
 
-            state.captures[state.current_player] += execute_move(&state, &our_move);
-            state.current_player = (state.current_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
-            state.turn_number++;
+            make_move(&state, &our_move, NULL);
 
             if (is_game_over(&state)) {
                 send_result(&our_move, &state);
@@ -114,8 +222,16 @@ int main(int argc, char* argv[]) {
             }
 
             send_move(&our_move);
+            if (pondering) start_ponder(&ponder, &our_ai, &book, &state);
         }
     }
 
+    if (ponder.active) {
+        search_abort(our_ai.ctx);
+        pthread_join(ponder.handle, NULL);
+    }
+    book_close(&book);
+    tb_close(&tablebase);
+    destroy_player(&our_ai);
     return 0;
 }
\ No newline at end of file
@@ -48,5 +48,7 @@ int main() {
 
     play_game(player1, player2, true);
 
+    destroy_player(&player1);
+    destroy_player(&player2);
     return 0;
 }
\ No newline at end of file
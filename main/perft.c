@@ -0,0 +1,250 @@
+//
+// perft.c - Comptage des feuilles de l'arbre des coups légaux
+//
+// Vérifie la génération de coups et les semailles contre des comptes de
+// référence, et mesure leur débit (nœuds par seconde).
+//
+// Usage : perft [-d depth] [-t threads] [-hash MB] [-divide] [-moves "3R 14B 4TR"]
+//   -d       profondeur maximale (comptes affichés pour 1..depth)
+//   -t       threads : les coups de la racine sont répartis entre eux
+//   -hash    perft haché : les sous-arbres déjà comptés sont réutilisés
+//   -divide  détail par coup de la racine à la profondeur maximale
+//   -moves   coups joués depuis la position initiale avant de compter
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/game.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_DEPTH 5
+#define MAX_THREADS 64
+
+// Comptes de référence depuis la position initiale. 1..6 : moteur d'origine
+// (copie de l'état à chaque coup) ; 7 : perft simple et haché concordants
+static const uint64_t reference_counts[] = {
+    0, 32ULL, 1024ULL, 30856ULL, 929896ULL, 26514320ULL, 756267936ULL, 20538641024ULL
+};
+#define REFERENCE_DEPTH ((int)(sizeof(reference_counts) / sizeof(reference_counts[0])) - 1)
+
+/* ==== TABLE DE HACHAGE DES SOUS-ARBRES ==== */
+
+// check = clé ^ count, comme la table de transposition : partageable sans verrou
+typedef struct {
+    uint64_t check;
+    uint64_t count;
+} PerftEntry;
+
+static PerftEntry *perft_table;
+static uint64_t perft_mask;
+
+// La profondeur restante fait partie de la clé : même position, autre sous-arbre
+static inline uint64_t perft_key(uint64_t hash, int depth) {
+    return hash ^ ((uint64_t)depth * 0x9E3779B97F4A7C15ULL);
+}
+
+static int perft_table_init(size_t size_mb) {
+    size_t count = 1;
+    while (count * 2 * sizeof(PerftEntry) <= size_mb * 1024 * 1024) count *= 2;
+    perft_table = calloc(count, sizeof(PerftEntry));
+    perft_mask = count - 1;
+    return perft_table != NULL;
+}
+
+static inline int perft_probe(uint64_t key, uint64_t *count) {
+    PerftEntry *e = &perft_table[key & perft_mask];
+    uint64_t c = __atomic_load_n(&e->count, __ATOMIC_RELAXED);
+    uint64_t check = __atomic_load_n(&e->check, __ATOMIC_RELAXED);
+    if ((check ^ c) != key || c == 0) return 0;
+    *count = c;
+    return 1;
+}
+
+static inline void perft_store(uint64_t key, uint64_t count) {
+    PerftEntry *e = &perft_table[key & perft_mask];
+    __atomic_store_n(&e->count, count, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->check, key ^ count, __ATOMIC_RELAXED);
+}
+
+/* ==== PERFT ==== */
+
+static uint64_t perft(GameState *state, int depth) {
+    if (depth == 0) return 1;
+    if (is_game_over(state)) return 0;
+
+    Move moves[128];
+    int n = generate_legal_moves(state, moves);
+
+    // Comptage en bloc : au dernier niveau, le nombre de coups suffit
+    if (depth == 1) return (uint64_t)n;
+
+    uint64_t key = 0, total = 0;
+    if (perft_table) {
+        key = perft_key(state->hash, depth);
+        if (perft_probe(key, &total)) return total;
+    }
+
+    // Sans table, ni clé ni agrégats à tenir : coup nu sur une copie, moins
+    // cher que make_move suivi d'unmake_move
+    for (int i = 0; i < n; i++) {
+        if (perft_table) {
+            MoveUndo undo;
+            make_move(state, &moves[i], &undo);
+            total += perft(state, depth - 1);
+            unmake_move(state, &undo);
+        } else {
+            GameState child = *state;
+            make_move_bare(&child, &moves[i]);
+            total += perft(&child, depth - 1);
+        }
+    }
+
+    if (perft_table && total) perft_store(key, total);
+    return total;
+}
+
+/* ==== DÉCOUPAGE À LA RACINE ==== */
+
+typedef struct {
+    const GameState *root;
+    const Move *moves;
+    uint64_t *counts;        // Un compte par coup de la racine
+    int move_count;
+    int depth;
+    atomic_int next;         // Prochain coup de la racine à compter
+} RootSplit;
+
+static void *perft_worker(void *arg) {
+    RootSplit *split = arg;
+
+    for (;;) {
+        int i = atomic_fetch_add(&split->next, 1);
+        if (i >= split->move_count) break;
+
+        GameState child = *split->root;
+        if (perft_table) make_move(&child, &split->moves[i], NULL);
+        else make_move_bare(&child, &split->moves[i]);
+        split->counts[i] = perft(&child, split->depth - 1);
+    }
+    return NULL;
+}
+
+// Compte chaque coup de la racine, threads à la fois ; renvoie le total
+static uint64_t perft_root(const GameState *root, int depth, int threads,
+                           Move *moves, uint64_t *counts, int *move_count) {
+    *move_count = 0;
+    if (depth == 0) return 1;
+    if (is_game_over(root)) return 0;
+
+    int n = generate_legal_moves(root, moves);
+    *move_count = n;
+
+    RootSplit split = { root, moves, counts, n, depth, 0 };
+    atomic_init(&split.next, 0);
+
+    pthread_t handles[MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < threads && t < n; t++) {
+        if (pthread_create(&handles[started], NULL, perft_worker, &split) != 0) break;
+        started++;
+    }
+    perft_worker(&split);
+    for (int t = 0; t < started; t++) pthread_join(handles[t], NULL);
+
+    uint64_t total = 0;
+    for (int i = 0; i < n; i++) total += counts[i];
+    return total;
+}
+
+/* ==== PROGRAMME ==== */
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Joue une liste de coups séparés par des espaces depuis la position initiale
+static int apply_moves(GameState *state, const char *list) {
+    char buffer[1024];
+    snprintf(buffer, sizeof(buffer), "%s", list);
+
+    for (char *tok = strtok(buffer, " ,"); tok; tok = strtok(NULL, " ,")) {
+        Move move;
+        if (!parse_move(tok, &move) || !is_valid_move(state, &move)) {
+            fprintf(stderr, "Coup invalide dans la position : %s\n", tok);
+            return 0;
+        }
+        make_move(state, &move, NULL);
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    int max_depth = DEFAULT_DEPTH, threads = 1, divide = 0;
+    size_t hash_mb = 0;
+    const char *move_list = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) max_depth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-hash") == 0 && i + 1 < argc) hash_mb = (size_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-divide") == 0) divide = 1;
+        else if (strcmp(argv[i], "-moves") == 0 && i + 1 < argc) move_list = argv[++i];
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    GameState root;
+    init_game_state(&root);
+    if (move_list && !apply_moves(&root, move_list)) return 1;
+    int from_start = (move_list == NULL || move_list[0] == '\0');
+
+    if (hash_mb > 0 && !perft_table_init(hash_mb)) {
+        fprintf(stderr, "Allocation de la table de %zu Mo impossible\n", hash_mb);
+        return 1;
+    }
+
+    printf("=== PERFT === (%d threads, hash %zu Mo%s)\n", threads, hash_mb,
+           from_start ? "" : ", position donnée");
+    printf("Depth            Nodes      Time(s)        Nodes/s  Check\n");
+
+    int failures = 0;
+    Move moves[128];
+    uint64_t counts[128];
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        int n;
+        double start = now_seconds();
+        uint64_t nodes = perft_root(&root, depth, threads, moves, counts, &n);
+        double elapsed = now_seconds() - start;
+
+        const char *check = "-";
+        if (from_start && depth <= REFERENCE_DEPTH) {
+            check = (nodes == reference_counts[depth]) ? "OK" : "FAIL";
+            if (nodes != reference_counts[depth]) failures++;
+        }
+
+        printf("%5d  %15llu  %11.3f  %13.0f  %s\n", depth, (unsigned long long)nodes,
+               elapsed, elapsed > 0 ? nodes / elapsed : 0.0, check);
+        fflush(stdout);
+
+        if (divide && depth == max_depth) {
+            for (int i = 0; i < n; i++) {
+                const Move *m = &moves[i];
+                const char *color = (m->color == TRANSPARENT)
+                    ? (m->transparent_color == RED ? "TR" : "TB")
+                    : (m->color == RED ? "R" : "B");
+                printf("  %2d%-2s  %llu\n", m->hole_number, color, (unsigned long long)counts[i]);
+            }
+        }
+    }
+
+    free(perft_table);
+    return failures ? 1 : 0;
+}
@@ -2,9 +2,13 @@
  * replay_game.c
  * Programme pour rejouer une partie depuis une liste de coups
  * puis continuer en mode humain vs humain
+ *
+ * Usage : replay_game [coup]                  coups texte sur l'entrée standard
+ *         replay_game -f parties.bin [-g n] [coup]   partie n d'un fichier gamelog
  */
 
 #include "../include/game.h"
+#include "../include/gamelog.h"
 #include "../include/player.h"
 #include "../include/engine.h"
 #include <stdio.h>
@@ -40,14 +44,67 @@ int parse_replay_line(const char* line, Move* move, char* player) {
     return move_num;
 }
 
+static void continue_human_game(const GameState *start, int move_count);
+
+// Partie d'un fichier binaire : position reconstruite sans afficher les coups
+static int replay_from_file(const char *path, size_t index, int stop_at_move, GameState *state) {
+    GameLogFile file;
+    if (!gamelog_open(&file, path)) {
+        printf("Fichier de parties illisible: %s\n", path);
+        return -1;
+    }
+    const GameLogGame *game = gamelog_game(&file, index);
+    if (!game) {
+        printf("Partie %zu absente (%zu parties dans %s)\n", index, file.count, path);
+        gamelog_close(&file);
+        return -1;
+    }
+
+    static const char *ends[] = { "normale", "disqualification", "interrompue" };
+    printf("=== REPLAY DE PARTIE === %s, partie %zu/%zu\n", path, index, file.count);
+    printf("A: %.*s | B: %.*s | %u ms/coup | %d coups | fin %s | ",
+           GAMELOG_NAME_SIZE, game->players[0], GAMELOG_NAME_SIZE, game->players[1],
+           game->time_ms, game->move_count, game->end <= GAMELOG_END_UNFINISHED ? ends[game->end] : "?");
+    if (game->winner == GAMELOG_DRAW) printf("nul\n");
+    else if (game->winner == GAMELOG_UNKNOWN) printf("résultat inconnu\n");
+    else printf("victoire de %c\n", game->winner == PLAYER_1 ? 'A' : 'B');
+
+    int played = gamelog_replay(game, stop_at_move, state);
+    gamelog_close(&file);
+
+    printf("\nPosition après le coup %d:\n", played);
+    display_game_state(state);
+    return played;
+}
+
 int main(int argc, char* argv[]) {
     int stop_at_move = -1;
+    const char *path = NULL;
+    size_t game_index = 0;
 
-    if (argc > 1) {
-        stop_at_move = atoi(argv[1]);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) path = argv[++i];
+        else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) game_index = (size_t)atol(argv[++i]);
+        else stop_at_move = atoi(argv[i]);
+    }
+    if (stop_at_move >= 0) {
         printf("Arrêt après le coup %d\n", stop_at_move);
     }
 
+    if (path) {
+        GameState state;
+        int played = replay_from_file(path, game_index, stop_at_move, &state);
+        if (played < 0) return 1;
+        if (is_game_over(&state)) {
+            printf("\n*** PARTIE TERMINÉE ***\n");
+            printf("Score final - A: %d | B: %d\n",
+                   state.captures[PLAYER_1], state.captures[PLAYER_2]);
+            return 0;
+        }
+        continue_human_game(&state, played);
+        return 0;
+    }
+
     GameState state;
     init_game_state(&state);
 
@@ -82,8 +139,7 @@ int main(int argc, char* argv[]) {
                    player, state.current_player == PLAYER_1 ? 'A' : 'B');
         }
 
-        int captures = execute_move(&state, &move);
-        state.captures[state.current_player] += captures;
+        int captures = make_move(&state, &move, NULL);
 
         printf("\n");
         printf("|=====================================================================================================================|\n");
@@ -92,8 +148,6 @@ int main(int argc, char* argv[]) {
         printf("  -->  %d capture(s)  |\n", captures);
         printf("|============================================================|\n");
 
-        state.current_player = (state.current_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
-        state.turn_number++;
         move_count++;
 
         display_game_state(&state);
@@ -111,40 +165,42 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    continue_human_game(&state, move_count);
+    return 0;
+}
+
+static void continue_human_game(const GameState *start, int move_count) {
+    GameState state = *start;
+
     printf("\n=== Continuation en mode Humain vs Humain ===\n");
     display_game_state(&state);
 
     while (!is_game_over(&state)) {
         Move move;
         printf("\nJoueur %c, ", state.current_player == PLAYER_1 ? 'A' : 'B');
-        human_play(&state, &move);
+        human_play(NULL, &state, &move);
 
         if (!is_valid_move(&state, &move)) {
             printf("Coup invalide, réessayez.\n");
             continue;
         }
 
-        int captures = execute_move(&state, &move);
-        state.captures[state.current_player] += captures;
+        PlayerIndex mover = state.current_player;
+        int captures = make_move(&state, &move, NULL);
         move_count++;
 
         printf("\n");
         printf("|============================================================|\n");
         printf("|  COUP %2d : Joueur %c joue ", move_count,
-               state.current_player == PLAYER_1 ? 'A' : 'B');
+               mover == PLAYER_1 ? 'A' : 'B');
         display_move(&move);
         printf("  -->  %d capture(s)  |\n", captures);
         printf("|============================================================|\n");
 
-        state.current_player = (state.current_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
-        state.turn_number++;
-
         display_game_state(&state);
     }
 
     printf("\n*** PARTIE TERMINÉE ***\n");
     printf("Score final - A: %d | B: %d\n",
            state.captures[PLAYER_1], state.captures[PLAYER_2]);
-
-    return 0;
 }
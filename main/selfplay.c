@@ -0,0 +1,203 @@
+//
+// selfplay.c - Génération de positions étiquetées par parties de l'IA contre elle-même
+//
+// Chaque thread joue ses parties avec son propre contexte, à nombre de nœuds
+// ou profondeur fixe et sans horloge (mode déterministe) : une partie ne dépend
+// que de sa graine, quel que soit le nombre de threads. Les premiers coups
+// sont tirés au hasard pour varier les parties. Chaque position cherchée donne
+// un enregistrement (plateau, captures, trait, score, meilleur coup), complété
+// par le résultat une fois la partie finie, puis écrit en flux dans le fichier
+// sans doublon (SelfplayWriter).
+//
+// Usage : selfplay [-games n] [-j threads] [-nodes n] [-depth d] [-random plies]
+//                  [-engine ia] [-hash MB] [-s seed] [-o fichier]
+//   -nodes   nœuds par coup (défaut 5000 ; 0 avec -depth : profondeur seule)
+//   -random  demi-coups aléatoires en début de partie
+//   -o       fichier de sortie, complété s'il existe déjà
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/game.h"
+#include "../include/match.h"
+#include "../include/player.h"
+#include "../include/selfplay.h"
+#include "../include/tt.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_GAMES 1000
+#define DEFAULT_NODES 5000
+#define DEFAULT_RANDOM_PLIES 8
+#define DEFAULT_HASH_MB 4          // Un contexte par thread : petites tables
+#define MAX_GAME_PLIES 512         // Au-delà de la limite de 400 tours
+#define PROGRESS_EVERY 100
+#define MAX_THREADS 64
+
+typedef struct {
+    int games;
+    unsigned int seed;
+    int random_plies;
+    const PlayerInfo *engine;
+    SearchLimits limits;
+    atomic_int next;               // Prochaine partie à jouer
+
+    SelfplayWriter writer;         // Sous lock
+    long positions, duplicates;
+    int done;
+    int write_error;
+    pthread_mutex_t lock;
+    struct timespec start;
+} Selfplay;
+
+static double seconds_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/* ==== PARTIES ==== */
+
+// Joue la partie g et remplit records ; renvoie le nombre de positions cherchées
+static int play_selfplay_game(Selfplay *sp, Player *ai, int g, SelfplayRecord *records, uint64_t *keys) {
+    unsigned int rng = match_game_seed(sp->seed, g);
+    search_clear(ai->ctx);
+
+    GameState state;
+    init_game_state(&state);
+    int count = 0;
+
+    for (int ply = 0; ply < MAX_GAME_PLIES && !is_game_over(&state); ply++) {
+        Move moves[128], move;
+        int n = generate_legal_moves(&state, moves);
+        if (n == 0) break;
+
+        if (ply < sp->random_plies) {
+            move = moves[rand_r(&rng) % n];
+        } else {
+            ai->play(ai->ctx, &state, &move);
+            SelfplayRecord *r = &records[count];
+            selfplay_pack(&state, r);
+            r->move = pack_move(&move);
+            r->score = ai->ctx->stats.best_score;
+            r->depth = (uint8_t)ai->ctx->stats.completed_depth;
+            r->game = (uint32_t)g;
+            keys[count++] = state.hash;
+        }
+        make_move(&state, &move, NULL);
+    }
+
+    // Résultat final, du point de vue du joueur au trait de chaque position
+    int diff = state.captures[PLAYER_1] - state.captures[PLAYER_2];
+    for (int i = 0; i < count; i++) {
+        int result = (diff > 0) - (diff < 0);
+        records[i].result = (int8_t)(records[i].side == PLAYER_1 ? result : -result);
+    }
+    return count;
+}
+
+static void *worker_main(void *arg) {
+    Selfplay *sp = arg;
+    Player ai = sp->engine->create();
+    ai.ctx->limits = sp->limits;
+
+    SelfplayRecord records[MAX_GAME_PLIES];
+    uint64_t keys[MAX_GAME_PLIES];
+
+    int g;
+    while ((g = atomic_fetch_add(&sp->next, 1)) < sp->games) {
+        int count = play_selfplay_game(sp, &ai, g, records, keys);
+
+        pthread_mutex_lock(&sp->lock);
+        size_t before = sp->writer.count;
+        for (int i = 0; i < count; i++) selfplay_writer_add(&sp->writer, keys[i], &records[i]);
+        size_t added = sp->writer.count - before;
+        sp->positions += (long)added;
+        sp->duplicates += count - (long)added;
+        if (ferror(sp->writer.file)) sp->write_error = 1;
+
+        if (++sp->done % PROGRESS_EVERY == 0 || sp->done == sp->games) {
+            double s = seconds_since(&sp->start);
+            printf("[%d/%d] %ld positions, %ld doublons, %.0f positions/s\n", sp->done, sp->games,
+                   sp->positions, sp->duplicates, s > 0 ? (sp->positions + sp->duplicates) / s : 0.0);
+            fflush(stdout);
+        }
+        pthread_mutex_unlock(&sp->lock);
+    }
+
+    destroy_player(&ai);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    int threads = match_default_workers();
+    const char *path = SELFPLAY_DEFAULT_PATH, *engine = "pvs";
+    Selfplay sp = {
+        .games = DEFAULT_GAMES,
+        .seed = 1,
+        .random_plies = DEFAULT_RANDOM_PLIES,
+        .limits = { .max_nodes = DEFAULT_NODES, .deterministic = 1 },
+    };
+    tt_set_default_size_mb(DEFAULT_HASH_MB);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-games") == 0 && i + 1 < argc) sp.games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-nodes") == 0 && i + 1 < argc) sp.limits.max_nodes = atol(argv[++i]);
+        else if (strcmp(argv[i], "-depth") == 0 && i + 1 < argc) sp.limits.max_depth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-random") == 0 && i + 1 < argc) sp.random_plies = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-engine") == 0 && i + 1 < argc) engine = argv[++i];
+        else if (strcmp(argv[i], "-hash") == 0 && i + 1 < argc) tt_set_default_size_mb((size_t)atoi(argv[++i]));
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) sp.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) path = argv[++i];
+    }
+    if (sp.games < 0) sp.games = 0;
+    if (sp.random_plies < 0) sp.random_plies = 0;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (sp.limits.max_nodes <= 0 && sp.limits.max_depth <= 0) sp.limits.max_nodes = DEFAULT_NODES;
+
+    sp.engine = find_player(engine);
+    Player probe = sp.engine ? sp.engine->create() : (Player){0};
+    int searches = probe.ctx != NULL;
+    if (sp.engine) destroy_player(&probe);
+    if (!searches) {
+        fprintf(stderr, "IA de recherche inconnue ou sans contexte : %s\n", engine);
+        return 1;
+    }
+
+    if (!selfplay_writer_open(&sp.writer, path)) {
+        fprintf(stderr, "Impossible d'écrire %s.tmp\n", path);
+        return 1;
+    }
+    size_t previous = sp.writer.count;
+    printf("=== SELF-PLAY === %d parties, %s, nœuds %ld, profondeur %d, %d coups aléatoires, %d threads\n",
+           sp.games, engine, sp.limits.max_nodes, sp.limits.max_depth, sp.random_plies, threads);
+    if (previous > 0) printf("%zu positions reprises de %s\n", previous, path);
+
+    pthread_mutex_init(&sp.lock, NULL);
+    atomic_init(&sp.next, 0);
+    clock_gettime(CLOCK_MONOTONIC, &sp.start);
+
+    pthread_t handles[MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < threads && t < sp.games; t++) {
+        if (pthread_create(&handles[t], NULL, worker_main, &sp) != 0) break;
+        started++;
+    }
+    if (started == 0 && sp.games > 0) worker_main(&sp);
+    for (int t = 0; t < started; t++) pthread_join(handles[t], NULL);
+    pthread_mutex_destroy(&sp.lock);
+
+    size_t total = sp.writer.count;
+    if (sp.write_error || !selfplay_writer_close(&sp.writer)) {
+        fprintf(stderr, "Écriture de %s impossible\n", path);
+        return 1;
+    }
+    printf("Fichier écrit : %s (%zu positions, dont %ld nouvelles, %.1fs)\n",
+           path, total, sp.positions, seconds_since(&sp.start));
+    return 0;
+}
@@ -3,42 +3,85 @@
 //
 #include "../include/game.h"
 #include "../include/player.h"
-#include "../include/engine.h"
+#include "../include/match.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
-int main() {
-    srand(time(NULL));
+#define DEFAULT_GAMES 10
 
-    const int NUM_GAMES = 10;
-    int wins_player1 = 0;
-    int wins_player2 = 0;
-    int draws = 0;
+// Usage : simulation [-n games] [-j workers] [-t threads] [-s seed]
+//                   [-depth d] [-nodes n] [-movetime ms] [-det] [ia1 ia2]
+// ia1 commence toutes les parties. -det rend les recherches indépendantes de
+// la machine (pas d'horloge, budget de nœuds par défaut si aucune limite)
 
-    Player player1 = create_ai_alphabeta_player();
-    Player player2 = create_ai_alphabeta_player();
+typedef struct {
+    int wins_player1, wins_player2, draws, errors, finished, total;
+} SimulationResults;
 
-    for (int i = 0; i < NUM_GAMES; i++) {
-        int winner = play_game(player1, player2, false);
+static bool record_game(const MatchGame *g, void *user) {
+    SimulationResults *r = user;
 
-        if (winner == PLAYER_1) {
-            wins_player1++;
-        } else if (winner == PLAYER_2) {
-            wins_player2++;
-        } else {
-            draws++;
-        }
+    if (g->result == PLAYER_1) r->wins_player1++;
+    else if (g->result == PLAYER_2) r->wins_player2++;
+    else if (g->result == MATCH_ERROR) r->errors++;
+    else r->draws++;
 
-        if ((i + 1) % 10 == 0) {
-            printf("Progression: %d/%d parties completees\n", i + 1, NUM_GAMES);
-        }
+    r->finished++;
+    if (r->finished % 10 == 0) {
+        printf("Progression: %d/%d parties completees\n", r->finished, r->total);
+        fflush(stdout);
     }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    int num_games = DEFAULT_GAMES, threads = 1;
+    SearchLimits limits = {0};
+    int workers = match_default_workers();
+    unsigned int seed = (unsigned int)time(NULL);
+    const char *names[2] = { "alphabeta", "alphabeta" };
+    int num_names = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) num_games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) workers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-depth") == 0 && i + 1 < argc) limits.max_depth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-nodes") == 0 && i + 1 < argc) limits.max_nodes = atol(argv[++i]);
+        else if (strcmp(argv[i], "-movetime") == 0 && i + 1 < argc) limits.max_time_ms = atol(argv[++i]);
+        else if (strcmp(argv[i], "-det") == 0) limits.deterministic = 1;
+        else if (num_names < 2) names[num_names++] = argv[i];
+    }
+    if (num_games < 1) num_games = 1;
+
+    const PlayerInfo *player1 = find_player(names[0]);
+    const PlayerInfo *player2 = find_player(names[1]);
+    if (!player1 || !player2) {
+        fprintf(stderr, "IA inconnue: %s\n", !player1 ? names[0] : names[1]);
+        return 1;
+    }
+
+    MatchGame *games = calloc(num_games, sizeof(MatchGame));
+    if (!games) return 1;
+    for (int i = 0; i < num_games; i++) {
+        games[i] = (MatchGame){ player1, player2, 0, 1, match_game_seed(seed, i), threads, limits, 0 };
+    }
+
+    printf("%s vs %s : %d parties, %d workers, graine %u\n",
+           player1->id, player2->id, num_games, workers, seed);
+
+    SimulationResults r = { 0, 0, 0, 0, 0, num_games };
+    run_match_games(games, num_games, workers, false, record_game, &r);
 
     printf("\n=== RESULTATS ===\n");
-    printf("Victoires Joueur 1: %d (%.1f%%)\n", wins_player1, (wins_player1 * 100.0) / NUM_GAMES);
-    printf("Victoires Joueur 2: %d (%.1f%%)\n", wins_player2, (wins_player2 * 100.0) / NUM_GAMES);
-    printf("Matchs nuls: %d (%.1f%%)\n", draws, (draws * 100.0) / NUM_GAMES);
+    printf("Victoires Joueur 1: %d (%.1f%%)\n", r.wins_player1, (r.wins_player1 * 100.0) / num_games);
+    printf("Victoires Joueur 2: %d (%.1f%%)\n", r.wins_player2, (r.wins_player2 * 100.0) / num_games);
+    printf("Matchs nuls: %d (%.1f%%)\n", r.draws, (r.draws * 100.0) / num_games);
+    if (r.errors) printf("Parties en erreur: %d\n", r.errors);
 
+    free(games);
     return 0;
 }
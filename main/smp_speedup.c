@@ -0,0 +1,101 @@
+#include "../include/game.h"
+#include "../include/ai_pvs_v2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Rapport de speedup Lazy SMP : pour 1..N threads, temps pour atteindre la
+// profondeur complétée par la recherche à 1 thread, et profondeur atteinte
+// dans la limite de temps fixe (TIME_LIMIT_MS)
+//
+// Usage : smp_speedup [-t max_threads] [-p positions]
+
+#define DEFAULT_MAX_THREADS 4
+#define DEFAULT_POSITIONS 4
+#define MAX_POSITIONS 32
+
+// Positions de test : ouvertures aléatoires à graine fixe (reproductibles)
+static void build_positions(GameState *positions, int count) {
+    srand(12345);
+    for (int p = 0; p < count; p++) {
+        GameState *s = &positions[p];
+        init_game_state(s);
+        int plies = 6 + 2 * p;
+        for (int i = 0; i < plies && !is_game_over(s); i++) {
+            Move moves[128];
+            int n = generate_legal_moves(s, moves);
+            if (n == 0) break;
+            make_move(s, &moves[rand() % n], NULL);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int max_threads = DEFAULT_MAX_THREADS, num_positions = DEFAULT_POSITIONS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) max_threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) num_positions = atoi(argv[++i]);
+    }
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > PVS_V2_MAX_THREADS) max_threads = PVS_V2_MAX_THREADS;
+    if (num_positions < 1) num_positions = 1;
+    if (num_positions > MAX_POSITIONS) num_positions = MAX_POSITIONS;
+
+    GameState positions[MAX_POSITIONS];
+    build_positions(positions, num_positions);
+
+    SearchContext *ctx = search_create();
+    if (!ctx) {
+        fprintf(stderr, "Allocation du contexte de recherche impossible\n");
+        return 1;
+    }
+
+    printf("\n=== LAZY SMP SPEEDUP === (%d positions, %d ms/search)\n", num_positions, TIME_LIMIT_MS);
+
+    int ref_depth[MAX_POSITIONS];
+    long ref_time[MAX_POSITIONS];
+
+    printf("Threads  Depth   Knodes/s   Eval hits   Time-to-depth  Speedup\n");
+    for (int t = 1; t <= max_threads; t++) {
+        ctx->num_threads = t;
+        double depth_sum = 0, log_speedup = 0, nps_sum = 0;
+        long eval_probes = 0, eval_hits = 0;
+        long ttd_sum = 0;
+        int compared = 0;
+
+        for (int p = 0; p < num_positions; p++) {
+            Move move;
+            search_clear(ctx);
+            ai_pvs_v2_move(ctx, &positions[p], &move);
+            const SearchStats st = ctx->stats;
+
+            depth_sum += st.completed_depth;
+            nps_sum += st.elapsed_ms > 0 ? (double)st.nodes / st.elapsed_ms : 0;
+            eval_probes += st.eval_cache.probes;
+            eval_hits += st.eval_cache.hits;
+
+            // La référence est la profondeur atteinte par la recherche à 1 thread
+            if (t == 1) {
+                ref_depth[p] = st.completed_depth;
+                ref_time[p] = st.depth_time_ms[st.completed_depth];
+            }
+            long ms = st.depth_time_ms[ref_depth[p]];
+            if (ms >= 0) {
+                ttd_sum += ms;
+                log_speedup += log((double)(ref_time[p] > 0 ? ref_time[p] : 1) / (ms > 0 ? ms : 1));
+                compared++;
+            }
+        }
+
+        printf("%7d  %5.2f  %9.0f   %8.1f%%   %10ld ms  ", t, depth_sum / num_positions,
+               nps_sum / num_positions, eval_probes ? 100.0 * eval_hits / eval_probes : 0.0,
+               compared ? ttd_sum / compared : -1L);
+        if (compared) printf("%6.2fx\n", exp(log_speedup / compared));
+        else printf("    n/a\n");
+    }
+
+    search_destroy(ctx);
+    return 0;
+}
@@ -1,74 +1,240 @@
 #include "../include/game.h"
 #include "../include/player.h"
 #include "../include/engine.h"
+#include "../include/match.h"
+#include "../include/sprt.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
 
-#define NUM_AIS 2
+#define MAX_AIS 16
 #define GAMES_PER_MATCH 4
+#define SPRT_MAX_GAMES 2000
+
+// Usage : tournament [-v] [-q] [-n games] [-j workers] [-t threads] [-s seed] [ia ...]
+//        options de recherche : [-depth d] [-nodes n] [-movetime ms] [-det]
+//         tournament -sprt [-elo0 0] [-elo1 5] [-alpha 0.05] [-beta 0.05] [-n max] ia_testee ia_reference
+// Les IA sont désignées par leur nom dans le registre (pvs, pvs_v2, mtdf...)
 
 typedef struct {
-    Player player;
+    const PlayerInfo *info;
     int wins, losses, draws, points;
 } AIEntry;
 
-void run_match(AIEntry *a1, AIEntry *a2, int games, int verbose) {
-    int w1 = 0, w2 = 0, d = 0;
-    printf("\n%s vs %s (%d games)\n", a1->player.name, a2->player.name, games);
-
-    for (int i = 0; i < games; i++) {
-        int r;
-        if (i % 2 == 0) {
-            r = play_game(a1->player, a2->player, verbose);
-            if (r == PLAYER_1) w1++; else if (r == PLAYER_2) w2++; else d++;
-        } else {
-            r = play_game(a2->player, a1->player, verbose);
-            if (r == PLAYER_1) w2++; else if (r == PLAYER_2) w1++; else d++;
-        }
-        if (!verbose) printf("  Game %d: %s\n", i + 1,
-            ((i % 2 == 0 && r == PLAYER_1) || (i % 2 == 1 && r == PLAYER_2)) ? a1->player.name :
-            ((i % 2 == 0 && r == PLAYER_2) || (i % 2 == 1 && r == PLAYER_1)) ? a2->player.name : "Draw");
+typedef struct {
+    int a, b;              // Index des deux IA dans le tableau des entrées
+    int w1, w2, d;         // Victoires de a, de b, nuls
+} Pairing;
+
+typedef struct {
+    AIEntry *ais;
+    Pairing *pairings;
+    int pair_index[MAX_AIS][MAX_AIS];
+    int finished, total;
+} Tournament;
+
+static bool record_game(const MatchGame *g, void *user) {
+    Tournament *t = user;
+    Pairing *p = &t->pairings[t->pair_index[g->id1][g->id2]];
+    t->finished++;
+
+    const char *winner = "Draw";
+    if (g->result == MATCH_ERROR) {
+        winner = "Error";
+    } else if (g->result == PLAYER_1 || g->result == PLAYER_2) {
+        int w = (g->result == PLAYER_1) ? g->id1 : g->id2;
+        if (w == p->a) p->w1++; else p->w2++;
+        winner = t->ais[w].info->id;
+    } else {
+        p->d++;
+    }
+
+    printf("  [%d/%d] %s vs %s: %s\n", t->finished, t->total,
+           g->player1->id, g->player2->id, winner);
+    fflush(stdout);
+    return true;
+}
+
+/* ==== MODE SPRT ==== */
+
+typedef struct {
+    Sprt sprt;
+    double *scores;        // Score de l'IA testée par partie, < 0 tant qu'inconnu
+    int decided;
+} SprtMatch;
+
+// Partie 2k : l'IA testée commence ; partie 2k + 1 : même graine, couleurs inversées
+static bool record_sprt_game(const MatchGame *g, void *user) {
+    SprtMatch *m = user;
+    int index = 2 * g->id1 + g->id2;    // id1 = numéro de paire, id2 = 0 ou 1
+    int tested = (g->id2 == 0) ? PLAYER_1 : PLAYER_2;
+
+    if (g->result == MATCH_ERROR) m->scores[index] = -2.0;   // Paire écartée
+    else if (g->result == tested) m->scores[index] = 1.0;
+    else if (g->result == -1) m->scores[index] = 0.5;
+    else m->scores[index] = 0.0;
+
+    double a = m->scores[2 * g->id1], b = m->scores[2 * g->id1 + 1];
+    if (m->decided || a == -1.0 || b == -1.0) return !m->decided;
+    if (a < 0 || b < 0) return true;
+
+    sprt_add_pair(&m->sprt, a, b);
+
+    double lower, upper;
+    sprt_bounds(&m->sprt, &lower, &upper);
+    printf("  pairs=%d W/L/D=%d/%d/%d LLR=%.2f [%.2f, %.2f]\n", sprt_pairs(&m->sprt),
+           m->sprt.wins, m->sprt.losses, m->sprt.draws, sprt_llr(&m->sprt), lower, upper);
+    fflush(stdout);
+
+    m->decided = sprt_status(&m->sprt) != SPRT_CONTINUE;
+    return !m->decided;
+}
+
+static int run_sprt(const PlayerInfo *test, const PlayerInfo *base, int max_games, int workers,
+                    int threads, SearchLimits limits, unsigned int seed, double elo0, double elo1, double alpha, double beta) {
+    int pairs = (max_games + 1) / 2;
+    MatchGame *list = calloc(2 * pairs, sizeof(MatchGame));
+    SprtMatch m = { .decided = 0 };
+    m.scores = malloc(2 * pairs * sizeof(double));
+    if (!list || !m.scores) return 1;
+
+    sprt_init(&m.sprt, elo0, elo1, alpha, beta);
+    for (int k = 0; k < pairs; k++) {
+        unsigned int pair_seed = match_game_seed(seed, k);
+        list[2 * k] = (MatchGame){ test, base, k, 0, pair_seed, threads, limits, 0 };
+        list[2 * k + 1] = (MatchGame){ base, test, k, 1, pair_seed, threads, limits, 0 };
+        m.scores[2 * k] = m.scores[2 * k + 1] = -1.0;
     }
 
-    printf("Result: %s %d - %d %s (draws: %d)\n", a1->player.name, w1, w2, a2->player.name, d);
+    printf("\n=== SPRT === %s vs %s, elo0=%.1f elo1=%.1f alpha=%.3f beta=%.3f (max %d games, %d workers, seed %u)\n",
+           test->id, base->id, elo0, elo1, alpha, beta, 2 * pairs, workers, seed);
+    run_match_games(list, 2 * pairs, workers, false, record_sprt_game, &m);
+
+    const Sprt *sp = &m.sprt;
+    double elo, error;
+    sprt_elo(sp, &elo, &error);
+    int status = sprt_status(sp);
 
-    a1->wins += w1; a1->losses += w2; a1->draws += d; a1->points += w1 * 3 + d;
-    a2->wins += w2; a2->losses += w1; a2->draws += d; a2->points += w2 * 3 + d;
+    printf("\n=== SPRT RESULT ===\n");
+    printf("Games: %d (W %d / L %d / D %d)\n", 2 * sprt_pairs(sp), sp->wins, sp->losses, sp->draws);
+    printf("Pentanomial [0, 0.5, 1, 1.5, 2]: [%d, %d, %d, %d, %d]\n",
+           sp->penta[0], sp->penta[1], sp->penta[2], sp->penta[3], sp->penta[4]);
+    printf("Elo: %+.1f +/- %.1f (95%%)\n", elo, error);
+    printf("LLR: %.2f -> %s\n", sprt_llr(sp),
+           status == SPRT_ACCEPT_H1 ? "H1 accepted" :
+           status == SPRT_ACCEPT_H0 ? "H0 accepted" : "inconclusive (max games reached)");
+
+    free(m.scores);
+    free(list);
+    return 0;
 }
 
 int main(int argc, char *argv[]) {
-    srand(time(NULL));
-    int verbose = 0, games = GAMES_PER_MATCH;
+    int verbose = 0, games = GAMES_PER_MATCH, threads = 1, sprt = 0, games_set = 0;
+    double elo0 = 0.0, elo1 = 5.0, alpha = 0.05, beta = 0.05;
+    SearchLimits limits = {0};
+    int workers = match_default_workers();
+    unsigned int seed = (unsigned int)time(NULL);
+    const char *names[MAX_AIS];
+    int num_ais = 0;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-v") == 0) verbose = 1;
         else if (strcmp(argv[i], "-q") == 0) games = 2;
-        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) { games = atoi(argv[++i]); games_set = 1; }
+        else if (strcmp(argv[i], "-sprt") == 0) sprt = 1;
+        else if (strcmp(argv[i], "-elo0") == 0 && i + 1 < argc) elo0 = atof(argv[++i]);
+        else if (strcmp(argv[i], "-elo1") == 0 && i + 1 < argc) elo1 = atof(argv[++i]);
+        else if (strcmp(argv[i], "-alpha") == 0 && i + 1 < argc) alpha = atof(argv[++i]);
+        else if (strcmp(argv[i], "-beta") == 0 && i + 1 < argc) beta = atof(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) workers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-depth") == 0 && i + 1 < argc) limits.max_depth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-nodes") == 0 && i + 1 < argc) limits.max_nodes = atol(argv[++i]);
+        else if (strcmp(argv[i], "-movetime") == 0 && i + 1 < argc) limits.max_time_ms = atol(argv[++i]);
+        else if (strcmp(argv[i], "-det") == 0) limits.deterministic = 1;
+        else if (num_ais < MAX_AIS) names[num_ais++] = argv[i];
+    }
+
+    if (num_ais == 0) {
+        names[num_ais++] = "pvs";
+        names[num_ais++] = "pvs_v2";
+    }
+
+    AIEntry ais[MAX_AIS];
+    for (int i = 0; i < num_ais; i++) {
+        const PlayerInfo *info = find_player(names[i]);
+        if (!info) {
+            int n;
+            const PlayerInfo *reg = player_registry(&n);
+            fprintf(stderr, "IA inconnue: %s\nDisponibles:", names[i]);
+            for (int k = 0; k < n; k++) fprintf(stderr, " %s", reg[k].id);
+            fprintf(stderr, "\n");
+            return 1;
+        }
+        ais[i] = (AIEntry){ info, 0, 0, 0, 0 };
     }
 
-    printf("\n=== TOURNAMENT === (%d games/match)\n", games);
+    if (sprt) {
+        if (num_ais != 2) {
+            fprintf(stderr, "Le mode SPRT compare exactement deux IA\n");
+            return 1;
+        }
+        return run_sprt(ais[0].info, ais[1].info, games_set ? games : SPRT_MAX_GAMES,
+                        workers, threads, limits, seed, elo0, elo1, alpha, beta);
+    }
+
+    // Les parties affichées en parallèle s'entremêleraient
+    if (verbose) workers = 1;
+
+    int num_pairings = (num_ais * (num_ais - 1)) / 2;
+    int total = num_pairings * games;
+    Pairing *pairings = calloc(num_pairings > 0 ? num_pairings : 1, sizeof(Pairing));
+    MatchGame *list = calloc(total > 0 ? total : 1, sizeof(MatchGame));
+    if (!pairings || !list) return 1;
+
+    Tournament t = { ais, pairings, {{0}}, 0, total };
 
-    AIEntry ais[NUM_AIS] = {
-        { create_ai_pvs_player(), 0, 0, 0, 0 },
-        { create_ai_pvs_v2_player(), 0, 0, 0, 0 }
-    };
+    // Chaque paire joue games parties en alternant le premier joueur
+    int p = 0, g = 0;
+    for (int i = 0; i < num_ais; i++) {
+        for (int j = i + 1; j < num_ais; j++, p++) {
+            pairings[p] = (Pairing){ i, j, 0, 0, 0 };
+            t.pair_index[i][j] = t.pair_index[j][i] = p;
+            for (int k = 0; k < games; k++, g++) {
+                int first = (k % 2 == 0) ? i : j, second = (k % 2 == 0) ? j : i;
+                list[g] = (MatchGame){ ais[first].info, ais[second].info, first, second,
+                                       match_game_seed(seed, g), threads, limits, 0 };
+            }
+        }
+    }
+
+    printf("\n=== TOURNAMENT === (%d games/match, %d workers, seed %u)\n", games, workers, seed);
+    run_match_games(list, total, workers, verbose, record_game, &t);
 
-    int total = (NUM_AIS * (NUM_AIS - 1)) / 2, match = 0;
-    for (int i = 0; i < NUM_AIS; i++)
-        for (int j = i + 1; j < NUM_AIS; j++)
-            { printf("\n[Match %d/%d]", ++match, total); run_match(&ais[i], &ais[j], games, verbose); }
+    printf("\n=== RESULTS ===\n");
+    for (p = 0; p < num_pairings; p++) {
+        Pairing *pr = &pairings[p];
+        AIEntry *a1 = &ais[pr->a], *a2 = &ais[pr->b];
+        printf("%s %d - %d %s (draws: %d)\n", a1->info->id, pr->w1, pr->w2, a2->info->id, pr->d);
+
+        a1->wins += pr->w1; a1->losses += pr->w2; a1->draws += pr->d; a1->points += pr->w1 * 3 + pr->d;
+        a2->wins += pr->w2; a2->losses += pr->w1; a2->draws += pr->d; a2->points += pr->w2 * 3 + pr->d;
+    }
 
     // Sort by points
-    for (int i = 0; i < NUM_AIS - 1; i++)
-        for (int j = i + 1; j < NUM_AIS; j++)
-            if (ais[j].points > ais[i].points) { AIEntry t = ais[i]; ais[i] = ais[j]; ais[j] = t; }
+    for (int i = 0; i < num_ais - 1; i++)
+        for (int j = i + 1; j < num_ais; j++)
+            if (ais[j].points > ais[i].points) { AIEntry tmp = ais[i]; ais[i] = ais[j]; ais[j] = tmp; }
 
     printf("\n=== STANDINGS ===\n");
     printf("%-12s  W    L    D   Pts\n", "AI");
-    for (int i = 0; i < NUM_AIS; i++)
-        printf("%-12s %3d  %3d  %3d  %3d\n", ais[i].player.name, ais[i].wins, ais[i].losses, ais[i].draws, ais[i].points);
+    for (int i = 0; i < num_ais; i++)
+        printf("%-12s %3d  %3d  %3d  %3d\n", ais[i].info->id, ais[i].wins, ais[i].losses, ais[i].draws, ais[i].points);
 
+    free(list);
+    free(pairings);
     return 0;
 }
@@ -4,6 +4,7 @@
 
 #include "../include/ai_alpha_beta.h"
 #include "../include/game.h"
+#include "../include/search.h"
 #include <limits.h>
 #include <stdio.h>
 #include <string.h>
@@ -11,130 +12,72 @@
 #include <stdint.h>
 #include <time.h>
 
-#define MAX_DEPTH 50
 #define WIN_SCORE 100000
 #define SEEDS_TO_WIN 49
 #define TIME_LIMIT_MS 3000
-#define HASH_SIZE 1048576
 #define ASPIRATION_WINDOW 50
 
-#define TT_EXACT 0
-#define TT_LOWER 1
-#define TT_UPPER 2
-
-typedef struct {
-    uint64_t hash;
-    int depth;
-    int score;
-    int flag;
-    Move best_move;
-    int valid;
-} TTEntry;
-
-static TTEntry transposition_table[HASH_SIZE];
-static Move killer_moves[MAX_DEPTH][2];
-static int history_table[NUM_HOLES][3];  // History heuristic [hole][color]
-
-static clock_t start_time;
-static int time_exceeded;
-static int nodes_searched;
-
 // Vérifie si le temps est écoulé - version corrigée
-static int is_time_up(void) {
-    nodes_searched++;
-    if (nodes_searched % 1024 == 0) {
-        clock_t now = clock();
-        long elapsed = (now - start_time) * 1000 / CLOCKS_PER_SEC;
-        if (elapsed >= TIME_LIMIT_MS) {
-            time_exceeded = 1;
-            return 1;
-        }
-    }
-    return time_exceeded;
-}
-
-static uint64_t compute_hash(const GameState *state) {
-    uint64_t hash = 0;
-    for (int i = 0; i < NUM_HOLES; i++) {
-        hash ^= (uint64_t)(state->board[i].seeds[RED]) << (i * 3);
-        hash ^= (uint64_t)(state->board[i].seeds[BLUE]) << (i * 3 + 16);
-        hash ^= (uint64_t)(state->board[i].seeds[TRANSPARENT]) << (i * 3 + 32);
+static int is_time_up(SearchContext *ctx) {
+    if (search_limit_reached(ctx, ctx->stats.nodes++, search_node_budget(ctx))) {
+        ctx->time_exceeded = 1;
+        return 1;
     }
-    hash ^= (uint64_t)state->captures[0] << 48;
-    hash ^= (uint64_t)state->captures[1] << 54;
-    hash ^= (uint64_t)state->current_player << 63;
-    return hash;
+    return ctx->time_exceeded;
 }
 
-static void store_killer(int depth, const Move *move) {
+static void store_killer(SearchContext *ctx, int depth, const Move *move) {
     if (depth >= MAX_DEPTH) return;
-    if (killer_moves[depth][0].hole_number != move->hole_number ||
-        killer_moves[depth][0].color != move->color) {
-        killer_moves[depth][1] = killer_moves[depth][0];
-        killer_moves[depth][0] = *move;
+    if (!same_move(&ctx->killers[depth][0], move)) {
+        ctx->killers[depth][1] = ctx->killers[depth][0];
+        ctx->killers[depth][0] = *move;
     }
 }
 
-static int is_killer(int depth, const Move *move) {
+static int is_killer(SearchContext *ctx, int depth, const Move *move) {
     if (depth >= MAX_DEPTH) return 0;
-    return (killer_moves[depth][0].hole_number == move->hole_number &&
-            killer_moves[depth][0].color == move->color) ||
-           (killer_moves[depth][1].hole_number == move->hole_number &&
-            killer_moves[depth][1].color == move->color);
+    return same_move(&ctx->killers[depth][0], move) || same_move(&ctx->killers[depth][1], move);
 }
 
 // Met à jour l'historique pour les coups qui causent des coupures
-static void update_history(const Move *move, int depth) {
+static void update_history(SearchContext *ctx, const Move *move, int depth) {
     int idx = move->hole_number - 1;
     if (idx >= 0 && idx < NUM_HOLES) {
-        history_table[idx][move->color] += depth * depth;
-        if (history_table[idx][move->color] > 1000000) {
+        ctx->history[idx][move->color] += depth * depth;
+        if (ctx->history[idx][move->color] > 1000000) {
             for (int h = 0; h < NUM_HOLES; h++) {
                 for (int c = 0; c < 3; c++) {
-                    history_table[h][c] /= 2;
+                    ctx->history[h][c] /= 2;
                 }
             }
         }
     }
 }
 
-static int get_history_score(const Move *move) {
+static int get_history_score(SearchContext *ctx, const Move *move) {
     int idx = move->hole_number - 1;
     if (idx >= 0 && idx < NUM_HOLES) {
-        return history_table[idx][move->color];
+        return ctx->history[idx][move->color];
     }
     return 0;
 }
 
-static int evaluate(const GameState *state, PlayerIndex maximizing_player) {
+// Captures et plateau : ne dépend que de state->hash et du joueur (clé du cache)
+static int board_score(const GameState *state, PlayerIndex maximizing_player) {
     int my_captures = state->captures[maximizing_player];
     int opp_captures = state->captures[1 - maximizing_player];
+    int score = (my_captures - opp_captures) * 100;
 
-    if (my_captures >= SEEDS_TO_WIN) return WIN_SCORE - state->turn_number;
-    if (opp_captures >= SEEDS_TO_WIN) return -WIN_SCORE + state->turn_number;
+    PlayerIndex opp = 1 - maximizing_player;
+    const BoardSummary *summary = &state->summary;
 
-    int score = (my_captures - opp_captures) * 100;
+    int my_seeds = summary->seeds[maximizing_player], opp_seeds = summary->seeds[opp];
+    int my_threats = 3 * (summary->singles[maximizing_player] + summary->capturable[maximizing_player]);
+    int opp_threats = 3 * summary->capturable[opp];
+    int my_vulnerable = 2 * summary->singles[maximizing_player];
 
-    int my_seeds = 0, opp_seeds = 0;
-    int my_threats = 0, opp_threats = 0;
-    int my_vulnerable = 0;
-
-    for (int i = 0; i < NUM_HOLES; i++) {
-        int total = get_total_seeds_in_hole(&state->board[i]);
-
-        if (is_player_hole(i, maximizing_player)) {
-            my_seeds += total;
-            if (total >= 1 && total <= 3) my_threats += 3;
-            if (total == 1) my_vulnerable += 2;
-        } else {
-            opp_seeds += total;
-            if (total == 1) score += 5;
-            if (total == 2 || total == 3) {
-                opp_threats += 3;
-                score += 3;
-            }
-        }
-    }
+    score += 5 * summary->singles[opp];
+    score += 3 * summary->capturable[opp];
 
     score += (my_seeds - opp_seeds);
     score += (my_threats - opp_threats);
@@ -143,233 +86,214 @@ static int evaluate(const GameState *state, PlayerIndex maximizing_player) {
     return score;
 }
 
-// Tri des coups amélioré avec history heuristic
-static void order_moves(const GameState *state, Move *moves, int num_moves,
-                        int *scores, int depth, const Move *tt_move) {
-    for (int i = 0; i < num_moves; i++) {
-        // Priorité maximale au coup de la table de transposition
-        if (tt_move && tt_move->hole_number == moves[i].hole_number &&
-            tt_move->color == moves[i].color) {
-            scores[i] = 10000000;
-            continue;
-        }
-
-        // Priorité aux killer moves
-        if (is_killer(depth, &moves[i])) {
-            scores[i] = 5000000;
-            continue;
-        }
+// Victoire acquise : le score dépend du tour, il ne passe pas par le cache
+static int evaluate(SearchContext *ctx, const GameState *state, PlayerIndex maximizing_player) {
+    if (state->captures[maximizing_player] >= SEEDS_TO_WIN) return WIN_SCORE - state->turn_number;
+    if (state->captures[1 - maximizing_player] >= SEEDS_TO_WIN) return -WIN_SCORE + state->turn_number;
 
-        // Score basé sur captures + history heuristic
-        GameState copy = *state;
-        int captured = execute_move(&copy, &moves[i]);
-        scores[i] = captured * 100000 + get_history_score(&moves[i]);
+    int score;
+    uint64_t key = eval_cache_key(state, maximizing_player);
+    ctx->stats.eval_cache.probes++;
+    if (eval_cache_probe(&ctx->eval_cache, key, &score)) {
+        ctx->stats.eval_cache.hits++;
+        return score;
     }
+    score = board_score(state, maximizing_player);
+    eval_cache_store(&ctx->eval_cache, key, score);
+    return score;
+}
 
-    // Tri décroissant par score
-    for (int i = 0; i < num_moves - 1; i++) {
-        for (int j = i + 1; j < num_moves; j++) {
-            if (scores[j] > scores[i]) {
-                int tmp_score = scores[i];
-                scores[i] = scores[j];
-                scores[j] = tmp_score;
-
-                Move tmp_move = moves[i];
-                moves[i] = moves[j];
-                moves[j] = tmp_move;
-            }
-        }
-    }
+// Clé de tri : coup de la table, killers, puis captures + history heuristic
+static int order_key(SearchContext *ctx, const Move *move, int captured, int ply, const Move *tt_move) {
+    if (tt_move && same_move(tt_move, move)) return 10000000;
+    if (is_killer(ctx, ply, move)) return 5000000;
+    return captured * 100000 + get_history_score(ctx, move);
 }
 
-static int alphabeta(GameState *state, int depth, int alpha, int beta,
+static int alphabeta(SearchContext *ctx, GameState *state, int depth, int alpha, int beta,
                      int is_maximizing, PlayerIndex maximizing_player,
                      int null_move_allowed, int ply) {
 
-    if (time_exceeded || is_time_up()) return 0;
+    if (ctx->time_exceeded || is_time_up(ctx)) return 0;
 
     if (depth == 0 || is_game_over(state)) {
-        return evaluate(state, maximizing_player);
+        return evaluate(ctx, state, maximizing_player);
     }
 
-    uint64_t hash = compute_hash(state);
-    int tt_index = hash % HASH_SIZE;
-    TTEntry *tt_entry = &transposition_table[tt_index];
-    Move *tt_move = NULL;
-
-    if (tt_entry->valid && tt_entry->hash == hash && tt_entry->depth >= depth) {
-        if (tt_entry->flag == TT_EXACT) return tt_entry->score;
-        if (tt_entry->flag == TT_LOWER && tt_entry->score > alpha) alpha = tt_entry->score;
-        if (tt_entry->flag == TT_UPPER && tt_entry->score < beta) beta = tt_entry->score;
-        if (alpha >= beta) return tt_entry->score;
-        tt_move = &tt_entry->best_move;
+    uint64_t hash = state->hash;
+    TTEntry tt_entry;
+    Move tt_best, *tt_move = NULL;
+
+    if (tt_probe(&ctx->tt, hash, &tt_entry)) {
+        if (tt_entry.depth >= depth) {
+            if (tt_entry.flag == TT_EXACT) return tt_entry.score;
+            if (tt_entry.flag == TT_LOWER && tt_entry.score > alpha) alpha = tt_entry.score;
+            if (tt_entry.flag == TT_UPPER && tt_entry.score < beta) beta = tt_entry.score;
+            if (alpha >= beta) return tt_entry.score;
+        }
+        if (tt_entry.move != MOVE_NONE) {
+            tt_best = unpack_move(tt_entry.move);
+            tt_move = &tt_best;
+        }
     }
 
     if (null_move_allowed && depth >= 3 && !is_maximizing) {
-        GameState null_state = *state;
-        null_state.current_player = 1 - null_state.current_player;
-        int null_score = alphabeta(&null_state, depth - 3, alpha, beta, 1, maximizing_player, 0, ply + 1);
-        if (!time_exceeded && null_score >= beta) return beta;
+        make_null_move(state);
+        int null_score = alphabeta(ctx, state, depth - 3, alpha, beta, 1, maximizing_player, 0, ply + 1);
+        make_null_move(state);
+        if (!ctx->time_exceeded && null_score >= beta) return beta;
     }
 
-    Move legal_moves[128];
-    int num_moves = generate_legal_moves(state, legal_moves);
-    if (num_moves == 0) return evaluate(state, maximizing_player);
-
-    int scores[128];
-    order_moves(state, legal_moves, num_moves, scores, ply, tt_move);
+    ChildList children;
+    int num_moves = generate_children(state, &children);
+    if (num_moves == 0) return evaluate(ctx, state, maximizing_player);
+    for (int i = 0; i < num_moves; i++) {
+        SearchChild *c = &children.child[i];
+        c->score = order_key(ctx, &c->move, c->captured, ply, tt_move);
+    }
 
-    Move best_move = legal_moves[0];
+    Move best_move = children.child[0].move;
     int original_alpha = alpha;
 
     if (is_maximizing) {
         int max_eval = INT_MIN;
 
         for (int i = 0; i < num_moves; i++) {
-            if (time_exceeded) break;
+            if (ctx->time_exceeded) break;
 
-            GameState copy = *state;
-            int captured = execute_move(&copy, &legal_moves[i]);
-            copy.captures[copy.current_player] += captured;
-            copy.current_player = 1 - copy.current_player;
+            SearchChild *c = next_child(&children);
+            tt_prefetch(&ctx->tt, c->state.hash);
 
             int eval;
-            if (i >= 4 && depth >= 3 && captured == 0) {
-                eval = alphabeta(&copy, depth - 2, alpha, beta, 0, maximizing_player, 1, ply + 1);
-                if (!time_exceeded && eval > alpha) {
-                    eval = alphabeta(&copy, depth - 1, alpha, beta, 0, maximizing_player, 1, ply + 1);
+            if (i >= 4 && depth >= 3 && c->captured == 0) {
+                eval = alphabeta(ctx, &c->state, depth - 2, alpha, beta, 0, maximizing_player, 1, ply + 1);
+                if (!ctx->time_exceeded && eval > alpha) {
+                    eval = alphabeta(ctx, &c->state, depth - 1, alpha, beta, 0, maximizing_player, 1, ply + 1);
                 }
             } else {
-                eval = alphabeta(&copy, depth - 1, alpha, beta, 0, maximizing_player, 1, ply + 1);
+                eval = alphabeta(ctx, &c->state, depth - 1, alpha, beta, 0, maximizing_player, 1, ply + 1);
             }
 
-            if (time_exceeded) break;
+            if (ctx->time_exceeded) break;
 
-            if (eval > max_eval) { max_eval = eval; best_move = legal_moves[i]; }
+            if (eval > max_eval) { max_eval = eval; best_move = c->move; }
             if (eval > alpha) alpha = eval;
             if (beta <= alpha) {
-                store_killer(ply, &legal_moves[i]);
-                update_history(&legal_moves[i], depth);
+                store_killer(ctx, ply, &c->move);
+                update_history(ctx, &c->move, depth);
                 break;
             }
         }
 
-        if (!time_exceeded) {
-            tt_entry->hash = hash;
-            tt_entry->depth = depth;
-            tt_entry->score = max_eval;
-            tt_entry->best_move = best_move;
-            tt_entry->valid = 1;
-            tt_entry->flag = (max_eval <= original_alpha) ? TT_UPPER :
-                             (max_eval >= beta) ? TT_LOWER : TT_EXACT;
+        if (!ctx->time_exceeded) {
+            tt_store(&ctx->tt, hash, depth, max_eval,
+                     (max_eval <= original_alpha) ? TT_UPPER :
+                     (max_eval >= beta) ? TT_LOWER : TT_EXACT, &best_move);
         }
         return max_eval;
     } else {
         int min_eval = INT_MAX;
 
         for (int i = 0; i < num_moves; i++) {
-            if (time_exceeded) break;
+            if (ctx->time_exceeded) break;
 
-            GameState copy = *state;
-            int captured = execute_move(&copy, &legal_moves[i]);
-            copy.captures[copy.current_player] += captured;
-            copy.current_player = 1 - copy.current_player;
+            SearchChild *c = next_child(&children);
+            tt_prefetch(&ctx->tt, c->state.hash);
 
             int eval;
-            if (i >= 4 && depth >= 3 && captured == 0) {
-                eval = alphabeta(&copy, depth - 2, alpha, beta, 1, maximizing_player, 1, ply + 1);
-                if (!time_exceeded && eval < beta) {
-                    eval = alphabeta(&copy, depth - 1, alpha, beta, 1, maximizing_player, 1, ply + 1);
+            if (i >= 4 && depth >= 3 && c->captured == 0) {
+                eval = alphabeta(ctx, &c->state, depth - 2, alpha, beta, 1, maximizing_player, 1, ply + 1);
+                if (!ctx->time_exceeded && eval < beta) {
+                    eval = alphabeta(ctx, &c->state, depth - 1, alpha, beta, 1, maximizing_player, 1, ply + 1);
                 }
             } else {
-                eval = alphabeta(&copy, depth - 1, alpha, beta, 1, maximizing_player, 1, ply + 1);
+                eval = alphabeta(ctx, &c->state, depth - 1, alpha, beta, 1, maximizing_player, 1, ply + 1);
             }
 
-            if (time_exceeded) break;
+            if (ctx->time_exceeded) break;
 
-            if (eval < min_eval) { min_eval = eval; best_move = legal_moves[i]; }
+            if (eval < min_eval) { min_eval = eval; best_move = c->move; }
             if (eval < beta) beta = eval;
             if (beta <= alpha) {
-                store_killer(ply, &legal_moves[i]);
-                update_history(&legal_moves[i], depth);
+                store_killer(ctx, ply, &c->move);
+                update_history(ctx, &c->move, depth);
                 break;
             }
         }
 
-        if (!time_exceeded) {
-            tt_entry->hash = hash;
-            tt_entry->depth = depth;
-            tt_entry->score = min_eval;
-            tt_entry->best_move = best_move;
-            tt_entry->valid = 1;
-            tt_entry->flag = (min_eval <= original_alpha) ? TT_UPPER :
-                             (min_eval >= beta) ? TT_LOWER : TT_EXACT;
+        if (!ctx->time_exceeded) {
+            tt_store(&ctx->tt, hash, depth, min_eval,
+                     (min_eval <= original_alpha) ? TT_UPPER :
+                     (min_eval >= beta) ? TT_LOWER : TT_EXACT, &best_move);
         }
         return min_eval;
     }
 }
 
-void ai_alpha_beta_move(const GameState *state, Move *selected_move) {
-    Move legal_moves[128];
-    int num_moves = generate_legal_moves(state, legal_moves);
+void ai_alpha_beta_move(SearchContext *ctx, const GameState *state, Move *selected_move) {
+    // Enfants de la racine joués une fois : ordre initial par captures
+    // décroissantes (score_children), servi par next_child comme dans la recherche
+    ChildList root_children;
+    int num_moves = generate_children(state, &root_children);
     if (num_moves == 0) return;
 
-    start_time = clock();
-    time_exceeded = 0;
-    nodes_searched = 0;
+    search_start(ctx, TIME_LIMIT_MS, num_moves);
 
-    memset(killer_moves, 0, sizeof(killer_moves));
+    memset(ctx->killers, 0, sizeof(ctx->killers));
+    score_children(&root_children, ctx->killers, 0, NULL, 0);
+    SearchChild *root[MAX_LEGAL_MOVES];
+    for (int i = 0; i < num_moves; i++) root[i] = next_child(&root_children);
 
-    Move best_move = legal_moves[0];
+    Move best_move = root[0]->move;
     int best_score = INT_MIN;
     PlayerIndex maximizing_player = state->current_player;
     int completed_depth = 0;
     int prev_score = 0;
 
-    int scores[128];
-    order_moves(state, legal_moves, num_moves, scores, 0, NULL);
-
-    for (int depth = 1; depth <= MAX_DEPTH; depth++) {
-        if (time_exceeded) break;
+    for (int depth = 1; depth <= search_max_depth(ctx); depth++) {
+        if (ctx->time_exceeded) break;
 
         int alpha = (depth >= 4) ? prev_score - ASPIRATION_WINDOW : INT_MIN;
         int beta = (depth >= 4) ? prev_score + ASPIRATION_WINDOW : INT_MAX;
 
         int current_best_score = INT_MIN;
-        Move current_best_move = legal_moves[0];
+        Move current_best_move = root[0]->move;
 
         for (int i = 0; i < num_moves; i++) {
-            if (time_exceeded) break;
+            if (ctx->time_exceeded) break;
 
-            GameState copy = *state;
-            int captured = execute_move(&copy, &legal_moves[i]);
-            copy.captures[copy.current_player] += captured;
-            copy.current_player = 1 - copy.current_player;
+            // Copie de travail : une recherche interrompue ne défait pas ses coups
+            GameState pos = root[i]->state;
 
-            int score = alphabeta(&copy, depth - 1, alpha, beta, 0, maximizing_player, 1, 1);
+            int score = alphabeta(ctx, &pos, depth - 1, alpha, beta, 0, maximizing_player, 1, 1);
 
             // Re-recherche si hors fenêtre d'aspiration
-            if (!time_exceeded && (score <= alpha || score >= beta)) {
-                score = alphabeta(&copy, depth - 1, INT_MIN, INT_MAX, 0, maximizing_player, 1, 1);
+            if (!ctx->time_exceeded && (score <= alpha || score >= beta)) {
+                score = alphabeta(ctx, &pos, depth - 1, INT_MIN, INT_MAX, 0, maximizing_player, 1, 1);
             }
 
-            if (!time_exceeded && score > current_best_score) {
+            if (!ctx->time_exceeded && score > current_best_score) {
                 current_best_score = score;
-                current_best_move = legal_moves[i];
+                current_best_move = root[i]->move;
             }
         }
 
-        if (!time_exceeded) {
+        if (!ctx->time_exceeded) {
             best_score = current_best_score;
             best_move = current_best_move;
             prev_score = best_score;
             completed_depth = depth;
+            if (!search_continue(ctx, &best_move, best_score)) break;
         }
     }
 
-    printf("[Alpha-Beta] Profondeur: %d | Score: %d | Noeuds: %d | Temps: %ld ms\n",
-           completed_depth, best_score, nodes_searched,
-           (long)((clock() - start_time) * 1000 / CLOCKS_PER_SEC));
+    printf("[Alpha-Beta] Profondeur: %d | Score: %d | Noeuds: %ld | Temps: %ld ms\n",
+           completed_depth, best_score, ctx->stats.nodes,
+           search_elapsed_ms(ctx));
+
+    ctx->stats.completed_depth = completed_depth;
+    ctx->stats.best_score = best_score;
+    search_finish(ctx);
 
     *selected_move = best_move;
 }
\ No newline at end of file
@@ -11,135 +11,93 @@
 
 #define ASPIRATION_WINDOW 50
 
-static TTEntry tt[HASH_SIZE];
-static Move killers[MAX_DEPTH][2];
-static clock_t start_time;
-static int time_exceeded, nodes, tt_hits, cutoffs, window_fails;
-
-static int is_time_up(void) {
-    if (nodes++ % 1024 == 0)
-        return ((clock() - start_time) * 1000 / CLOCKS_PER_SEC) >= TIME_LIMIT_MS;
-    return 0;
+static int is_time_up(SearchContext *ctx) {
+    return search_limit_reached(ctx, ctx->stats.nodes++, search_node_budget(ctx));
 }
 
-static void store_killer(int ply, const Move *m) {
+static void store_killer(SearchContext *ctx, int ply, const Move *m) {
     if (ply >= MAX_DEPTH) return;
-    if (killers[ply][0].hole_number != m->hole_number || killers[ply][0].color != m->color) {
-        killers[ply][1] = killers[ply][0];
-        killers[ply][0] = *m;
+    if (!same_move(&ctx->killers[ply][0], m)) {
+        ctx->killers[ply][1] = ctx->killers[ply][0];
+        ctx->killers[ply][0] = *m;
     }
 }
 
-static int is_killer(int ply, const Move *m) {
-    if (ply >= MAX_DEPTH) return 0;
-    return (killers[ply][0].hole_number == m->hole_number && killers[ply][0].color == m->color) ||
-           (killers[ply][1].hole_number == m->hole_number && killers[ply][1].color == m->color);
-}
-
-static void order_moves(const GameState *state, Move *moves, int n, int *scores, int ply, const Move *tt_move) {
-    for (int i = 0; i < n; i++) {
-        if (tt_move && tt_move->hole_number == moves[i].hole_number && tt_move->color == moves[i].color)
-            scores[i] = 1000000;
-        else if (is_killer(ply, &moves[i]))
-            scores[i] = 500000;
-        else {
-            GameState copy = *state;
-            scores[i] = execute_move(&copy, &moves[i]) * 1000;
-        }
-    }
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = i + 1; j < n; j++) {
-            if (scores[j] > scores[i]) {
-                int ts = scores[i]; scores[i] = scores[j]; scores[j] = ts;
-                Move tm = moves[i]; moves[i] = moves[j]; moves[j] = tm;
-            }
+static int alphabeta(SearchContext *ctx, GameState *state, int depth, int alpha, int beta, int maximizing, PlayerIndex max_player, int ply) {
+    if (is_time_up(ctx)) { ctx->time_exceeded = 1; return 0; }
+    if (depth == 0 || is_game_over(state)) return cached_evaluate(ctx, &ctx->stats.eval_cache, state, max_player);
+
+    uint64_t hash = state->hash;
+    TTEntry e;
+    Move tt_best, *tt_move = NULL;
+
+    if (tt_probe(&ctx->tt, hash, &e)) {
+        if (e.depth >= depth) {
+            ctx->stats.tt_hits++;
+            if (e.flag == TT_EXACT) return e.score;
+            if (e.flag == TT_LOWER && e.score > alpha) alpha = e.score;
+            if (e.flag == TT_UPPER && e.score < beta) beta = e.score;
+            if (alpha >= beta) return e.score;
         }
+        if (e.move != MOVE_NONE) { tt_best = unpack_move(e.move); tt_move = &tt_best; }
     }
-}
 
-static int alphabeta(GameState *state, int depth, int alpha, int beta, int maximizing, PlayerIndex max_player, int ply) {
-    if (is_time_up()) { time_exceeded = 1; return 0; }
-    if (depth == 0 || is_game_over(state)) return base_evaluate(state, max_player);
-
-    uint64_t hash = compute_hash(state);
-    int idx = hash % HASH_SIZE;
-    TTEntry *e = &tt[idx];
-    Move *tt_move = NULL;
-
-    if (e->valid && e->hash == hash && e->depth >= depth) {
-        tt_hits++;
-        if (e->flag == TT_EXACT) return e->score;
-        if (e->flag == TT_LOWER && e->score > alpha) alpha = e->score;
-        if (e->flag == TT_UPPER && e->score < beta) beta = e->score;
-        if (alpha >= beta) return e->score;
-        tt_move = &e->best_move;
-    }
+    ChildList children;
+    int n = generate_children(state, &children);
+    if (n == 0) return cached_evaluate(ctx, &ctx->stats.eval_cache, state, max_player);
+    score_children(&children, ctx->killers, ply, tt_move, depth);
 
-    Move moves[128];
-    int n = generate_legal_moves(state, moves);
-    if (n == 0) return base_evaluate(state, max_player);
-
-    int scores[128];
-    order_moves(state, moves, n, scores, ply, tt_move);
-
-    Move best = moves[0];
+    Move best = children.child[0].move;
     int orig_alpha = alpha;
 
     if (maximizing) {
         int max_eval = INT_MIN;
-        for (int i = 0; i < n && !time_exceeded; i++) {
-            GameState copy = *state;
-            int cap = execute_move(&copy, &moves[i]);
-            copy.captures[copy.current_player] += cap;
-            copy.current_player = 1 - copy.current_player;
-            copy.turn_number++;
-
-            int eval = alphabeta(&copy, depth - 1, alpha, beta, 0, max_player, ply + 1);
-            if (eval > max_eval) { max_eval = eval; best = moves[i]; }
+        for (int i = 0; i < n && !ctx->time_exceeded; i++) {
+            SearchChild *c = next_child(&children);
+            tt_prefetch(&ctx->tt, c->state.hash);
+
+            int eval = alphabeta(ctx, &c->state, depth - 1, alpha, beta, 0, max_player, ply + 1);
+            if (eval > max_eval) { max_eval = eval; best = c->move; }
             if (eval > alpha) alpha = eval;
-            if (beta <= alpha) { store_killer(ply, &moves[i]); cutoffs++; break; }
+            if (beta <= alpha) { store_killer(ctx, ply, &c->move); ctx->stats.cutoffs++; break; }
         }
-        if (!time_exceeded) {
-            e->hash = hash; e->depth = depth; e->score = max_eval; e->best_move = best; e->valid = 1;
-            e->flag = (max_eval <= orig_alpha) ? TT_UPPER : (max_eval >= beta) ? TT_LOWER : TT_EXACT;
+        if (!ctx->time_exceeded) {
+            tt_store(&ctx->tt, hash, depth, max_eval,
+                     (max_eval <= orig_alpha) ? TT_UPPER : (max_eval >= beta) ? TT_LOWER : TT_EXACT, &best);
         }
         return max_eval;
     } else {
         int min_eval = INT_MAX;
-        for (int i = 0; i < n && !time_exceeded; i++) {
-            GameState copy = *state;
-            int cap = execute_move(&copy, &moves[i]);
-            copy.captures[copy.current_player] += cap;
-            copy.current_player = 1 - copy.current_player;
-            copy.turn_number++;
-
-            int eval = alphabeta(&copy, depth - 1, alpha, beta, 1, max_player, ply + 1);
-            if (eval < min_eval) { min_eval = eval; best = moves[i]; }
+        for (int i = 0; i < n && !ctx->time_exceeded; i++) {
+            SearchChild *c = next_child(&children);
+            tt_prefetch(&ctx->tt, c->state.hash);
+
+            int eval = alphabeta(ctx, &c->state, depth - 1, alpha, beta, 1, max_player, ply + 1);
+            if (eval < min_eval) { min_eval = eval; best = c->move; }
             if (eval < beta) beta = eval;
-            if (beta <= alpha) { store_killer(ply, &moves[i]); cutoffs++; break; }
+            if (beta <= alpha) { store_killer(ctx, ply, &c->move); ctx->stats.cutoffs++; break; }
         }
-        if (!time_exceeded) {
-            e->hash = hash; e->depth = depth; e->score = min_eval; e->best_move = best; e->valid = 1;
-            e->flag = (min_eval <= orig_alpha) ? TT_UPPER : (min_eval >= beta) ? TT_LOWER : TT_EXACT;
+        if (!ctx->time_exceeded) {
+            tt_store(&ctx->tt, hash, depth, min_eval,
+                     (min_eval <= orig_alpha) ? TT_UPPER : (min_eval >= beta) ? TT_LOWER : TT_EXACT, &best);
         }
         return min_eval;
     }
 }
 
-static int search_root(GameState *state, Move *moves, int n, int depth, int alpha, int beta,
+static int search_root(SearchContext *ctx, GameState *state, Move *moves, int n, int depth, int alpha, int beta,
                        PlayerIndex max_player, Move *best_out) {
     int best_score = INT_MIN;
     Move best = moves[0];
 
-    for (int i = 0; i < n && !time_exceeded; i++) {
-        GameState copy = *state;
-        int cap = execute_move(&copy, &moves[i]);
-        copy.captures[copy.current_player] += cap;
-        copy.current_player = 1 - copy.current_player;
-        copy.turn_number++;
+    for (int i = 0; i < n && !ctx->time_exceeded; i++) {
+        MoveUndo undo;
+        make_move(state, &moves[i], &undo);
+        tt_prefetch(&ctx->tt, state->hash);
 
-        int score = alphabeta(&copy, depth - 1, alpha, beta, 0, max_player, 1);
-        if (!time_exceeded && score > best_score) { best_score = score; best = moves[i]; }
+        int score = alphabeta(ctx, state, depth - 1, alpha, beta, 0, max_player, 1);
+        unmake_move(state, &undo);
+        if (!ctx->time_exceeded && score > best_score) { best_score = score; best = moves[i]; }
         if (score > alpha) alpha = score;
     }
 
@@ -147,55 +105,62 @@ static int search_root(GameState *state, Move *moves, int n, int depth, int alph
     return best_score;
 }
 
-void ai_aspiration_move(const GameState *state, Move *selected_move) {
+void ai_aspiration_move(SearchContext *ctx, const GameState *state, Move *selected_move) {
     Move moves[128];
     int n = generate_legal_moves(state, moves);
     if (n == 0) return;
 
-    start_time = clock();
-    time_exceeded = 0; nodes = 0; tt_hits = 0; cutoffs = 0; window_fails = 0;
-    memset(killers, 0, sizeof(killers));
+    search_start(ctx, TIME_LIMIT_MS, n);
+    memset(ctx->killers, 0, sizeof(ctx->killers));
 
     Move best = moves[0];
     int best_score = 0, completed = 0;
 
+    // Position de travail : la recherche joue/défait les coups dessus
+    GameState pos = *state;
+
     int scores[128];
-    order_moves(state, moves, n, scores, 0, NULL);
+    order_moves(ctx, state, moves, n, scores, 0, NULL);
 
-    for (int depth = 1; depth <= MAX_DEPTH && !time_exceeded; depth++) {
+    for (int depth = 1; depth <= search_max_depth(ctx) && !ctx->time_exceeded; depth++) {
         Move curr_best = best;
         int score;
 
         if (depth <= 2) {
             // Fenêtre complète pour les premières itérations
-            score = search_root((GameState *)state, moves, n, depth, INT_MIN, INT_MAX,
+            score = search_root(ctx, &pos, moves, n, depth, INT_MIN, INT_MAX,
                                state->current_player, &curr_best);
         } else {
             // Aspiration window
             int alpha = best_score - ASPIRATION_WINDOW;
             int beta = best_score + ASPIRATION_WINDOW;
 
-            score = search_root((GameState *)state, moves, n, depth, alpha, beta,
+            score = search_root(ctx, &pos, moves, n, depth, alpha, beta,
                                state->current_player, &curr_best);
 
             // Re-search si hors fenêtre
-            if (!time_exceeded && (score <= alpha || score >= beta)) {
-                window_fails++;
-                score = search_root((GameState *)state, moves, n, depth, INT_MIN, INT_MAX,
+            if (!ctx->time_exceeded && (score <= alpha || score >= beta)) {
+                ctx->stats.re_searches++;
+                score = search_root(ctx, &pos, moves, n, depth, INT_MIN, INT_MAX,
                                    state->current_player, &curr_best);
             }
         }
 
-        if (!time_exceeded) {
+        if (!ctx->time_exceeded) {
             best_score = score;
             best = curr_best;
             completed = depth;
+            if (!search_continue(ctx, &best, best_score)) break;
         }
     }
 
-    printf("[Aspiration] depth=%d score=%d nodes=%d tt=%d cuts=%d w-fail=%d time=%ldms\n",
-           completed, best_score, nodes, tt_hits, cutoffs, window_fails,
-           (clock() - start_time) * 1000 / CLOCKS_PER_SEC);
+    printf("[Aspiration] depth=%d score=%d nodes=%ld tt=%ld cuts=%ld w-fail=%ld time=%ldms\n",
+           completed, best_score, ctx->stats.nodes, ctx->stats.tt_hits, ctx->stats.cutoffs, ctx->stats.re_searches,
+           search_elapsed_ms(ctx));
+
+    ctx->stats.completed_depth = completed;
+    ctx->stats.best_score = best_score;
+    search_finish(ctx);
 
     *selected_move = best;
 }
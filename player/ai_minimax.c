@@ -7,7 +7,7 @@
 #include <limits.h>
 #include <string.h>
 
-#define MAX_DEPTH 4
+#define MINIMAX_DEPTH 4
 
 // Fonction d'évaluation simple : différence de graines capturées
 static int evaluate(const GameState *state) {
@@ -56,7 +56,8 @@ static int minimax(GameState *state, int depth, int is_maximizing) {
 }
 
 // Fonction principale de l'IA Minimax
-void ai_minimax_move(const GameState *state, Move *selected_move) {
+void ai_minimax_move(SearchContext *ctx, const GameState *state, Move *selected_move) {
+    (void)ctx;
     Move legal_moves[128];
     int num_legal_moves = generate_legal_moves(state, legal_moves);
 
@@ -71,7 +72,7 @@ void ai_minimax_move(const GameState *state, Move *selected_move) {
         GameState state_copy = *state;
         execute_move(&state_copy, &legal_moves[i]);
 
-        int score = minimax(&state_copy, MAX_DEPTH - 1, 0);
+        int score = minimax(&state_copy, MINIMAX_DEPTH - 1, 0);
 
         if (score > best_score) {
             best_score = score;
@@ -3,53 +3,83 @@
 //
 // Optimisations par rapport à v1:
 //   1. Unified Negamax (évite duplication de code)
-//   2. Tri partiel au lieu de tri complet (O(n) vs O(n²))
+//   2. Coups servis par étapes (MovePicker) : coup de la table, killers,
+//      captures puis coups calmes selon l'historique, générés seulement si
+//      les étapes précédentes n'ont pas coupé
 //   3. Inlining des fonctions critiques
 //   4. Réduction des allocations temporaires
 //   5. Lisibilité améliorée avec sections claires
+//   6. Lazy SMP : N threads partagent la table de transposition sans verrou
 //
-#include "../include/ai_pvs.h"
+#include "../include/ai_pvs_v2.h"
 #include "../include/ai_common.h"
 #include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 // ============================================================================
-// CONSTANTES ET SCORES DE PRIORITÉ
+// ÉTAT D'UN THREAD DE RECHERCHE
 // ============================================================================
-#define SCORE_TT_MOVE      1000000  // Coup de la table de transposition
-#define SCORE_KILLER       500000   // Killer moves
-#define SCORE_CAPTURE_BASE 1000     // Multiplicateur pour captures
-
-// ============================================================================
-// VARIABLES GLOBALES
-// ============================================================================
-static TTEntry tt[HASH_SIZE];
-static Move killers[MAX_DEPTH][2];
-static clock_t start_time;
-static int time_exceeded, nodes, tt_hits, cutoffs, re_searches;
+// Chaque thread a sa propre position de travail, ses killers et ses compteurs ;
+// seule la table de transposition du contexte est partagée
+//
+typedef struct {
+    int id;                       // 0 = thread principal
+    SearchContext *ctx;
+    pthread_t handle;
+    GameState pos;
+    PlayerIndex max_player;
+    Move root_moves[128];
+    int move_count;
+
+    Move killers[MAX_DEPTH][2];
+    int history[NUM_HOLES][NUM_COLORS];   // Coups calmes ayant coupé, par trou et couleur
+    long nodes;
+    long node_budget;             // Part du budget de nœuds de ce thread (0 = illimité)
+    int tt_hits, tb_hits, cutoffs, re_searches;
+    EvalCacheStats eval_cache;
+    int time_exceeded;
+
+    // Dernière itération complète
+    int completed_depth;
+    int best_score;
+    Move best_move;
+    long depth_time_ms[MAX_DEPTH + 1];
+} SearchThread;
+
+// État propre à PVS v2, rangé dans ctx->engine_data
+typedef struct {
+    SearchThread threads[PVS_V2_MAX_THREADS];
+    atomic_int deepest_completed;    // Profondeur complète la plus grande, tous threads
+} PvsV2Data;
 
 // ============================================================================
 // GESTION DU TEMPS (inline pour performance)
 // ============================================================================
-static inline int is_time_up(void) {
-    // Vérifier le temps seulement tous les 1024 nœuds (évite overhead)
-    if (nodes++ % 1024 == 0) {
-        return ((clock() - start_time) * 1000 / CLOCKS_PER_SEC) >= TIME_LIMIT_MS;
-    }
-    return 0;
+static inline int is_time_up(SearchThread *t) {
+    // Aucune lecture d'horloge ici : le minuteur lève ctx->stop à la limite
+    // dure. On compte le nœud contre la part du thread et on lit le drapeau
+    if (!search_limit_reached(t->ctx, t->nodes++, t->node_budget)) return 0;
+
+    // Seul le principal arrête tout le monde : une aide qui épuise sa part
+    // abandonne sa propre recherche, sans toucher au résultat de la racine
+    if (t->id == 0) atomic_store_explicit(&t->ctx->stop, 1, memory_order_relaxed);
+    return 1;
 }
 
 // ============================================================================
 // KILLER MOVES (inline pour performance)
 // ============================================================================
-static inline void store_killer(int ply, const Move *m) {
+static inline void store_killer(SearchThread *t, int ply, const Move *m) {
     if (ply >= MAX_DEPTH) return;
+    Move (*killers)[2] = t->killers;
     
     // Éviter de stocker le même coup deux fois
-    if (killers[ply][0].hole_number == m->hole_number && 
-        killers[ply][0].color == m->color) {
+    if (same_move(&killers[ply][0], m)) {
         return;
     }
     
@@ -58,73 +88,19 @@ static inline void store_killer(int ply, const Move *m) {
     killers[ply][0] = *m;
 }
 
-static inline int is_killer(int ply, const Move *m) {
-    if (ply >= MAX_DEPTH) return 0;
-    
-    // Vérifier les 2 killers pour ce ply
-    return (killers[ply][0].hole_number == m->hole_number && 
-            killers[ply][0].color == m->color) ||
-           (killers[ply][1].hole_number == m->hole_number && 
-            killers[ply][1].color == m->color);
-}
-
 // ============================================================================
-// MOVE ORDERING - Tri par sélection partiel
+// HISTORIQUE DES COUPS CALMES
 // ============================================================================
-// Au lieu d'un tri complet O(n²), on fait un tri partiel :
-// - On place les meilleurs coups au début
-// - Les cutoffs arrivent tôt, donc pas besoin de trier tout le tableau
-//
-static void order_moves(const GameState *state, Move *moves, int n, 
-                       int *scores, int ply, const Move *tt_move) {
-    // Phase 1 : Attribution des scores
-    for (int i = 0; i < n; i++) {
-        // TT move : priorité maximale
-        if (tt_move && 
-            tt_move->hole_number == moves[i].hole_number && 
-            tt_move->color == moves[i].color) {
-            scores[i] = SCORE_TT_MOVE;
-            continue;
-        }
-        
-        // Killer moves : haute priorité
-        if (is_killer(ply, &moves[i])) {
-            scores[i] = SCORE_KILLER;
-            continue;
-        }
-        
-        // Autres coups : scorer selon les captures
-        GameState copy = *state;
-        int captures = execute_move(&copy, &moves[i]);
-        scores[i] = captures * SCORE_CAPTURE_BASE;
-    }
-    
-    // Phase 2 : Tri complet (nécessaire pour bon ordering)
-    // Le tri partiel était trop agressif et produisait un mauvais ordering
-    // Résultat : -30% de cutoffs, donc on revient au tri complet
-    for (int i = 0; i < n - 1; i++) {
-        // Trouver le meilleur coup restant
-        int best_idx = i;
-        int best_score = scores[i];
-
-        for (int j = i + 1; j < n; j++) {
-            if (scores[j] > best_score) {
-                best_idx = j;
-                best_score = scores[j];
-            }
-        }
+#define HISTORY_MAX 1000000
+
+static inline void update_history(SearchThread *t, const Move *m, int depth) {
+    int *entry = &t->history[m->hole_number - 1][m->color];
+    *entry += depth * depth;
 
-        // Échanger si nécessaire
-        if (best_idx != i) {
-            // Swap scores
-            int tmp_score = scores[i];
-            scores[i] = scores[best_idx];
-            scores[best_idx] = tmp_score;
-
-            // Swap moves
-            Move tmp_move = moves[i];
-            moves[i] = moves[best_idx];
-            moves[best_idx] = tmp_move;
+    // Vieillissement : tout diviser par deux plutôt que saturer
+    if (*entry > HISTORY_MAX) {
+        for (int h = 0; h < NUM_HOLES; h++) {
+            for (int c = 0; c < NUM_COLORS; c++) t->history[h][c] /= 2;
         }
     }
 }
@@ -135,93 +111,101 @@ static void order_moves(const GameState *state, Move *moves, int n,
 // Negamax : au lieu de séparer maximizing/minimizing, on inverse le score
 // score = -negamax(..., -beta, -alpha, ...)
 //
-static int negamax_pvs(GameState *state, int depth, int alpha, int beta,
-                       PlayerIndex max_player, int ply) {
+static int negamax_pvs(SearchThread *t, const GameState *state, int depth, int alpha, int beta, int ply) {
+    PlayerIndex max_player = t->max_player;
+
     // Vérifications préliminaires
-    if (is_time_up()) {
-        time_exceeded = 1;
+    if (is_time_up(t)) {
+        t->time_exceeded = 1;
         return 0;
     }
 
-    if (depth == 0 || is_game_over(state)) {
+    // Finale connue : score exact du point de vue du joueur au trait, aussi
+    // aux feuilles de l'horizon (partie finie : rien à jouer, on évalue)
+    int game_over = is_game_over(state);
+    int tb_score;
+    if (ply > 0 && !game_over && t->ctx->tablebase
+        && tb_probe_score(t->ctx->tablebase, state, state->current_player, &tb_score)) {
+        t->tb_hits++;
+        return tb_score;
+    }
+
+    if (depth == 0 || game_over) {
         // Évaluer du point de vue du joueur actuel
-        int score = base_evaluate(state, max_player);
+        int score = cached_evaluate(t->ctx, &t->eval_cache, state, max_player);
         return (state->current_player == max_player) ? score : -score;
     }
 
     // Consultation de la table de transposition
-    uint64_t hash = compute_hash(state);
-    int tt_idx = hash % HASH_SIZE;
-    TTEntry *entry = &tt[tt_idx];
-    Move *tt_move = NULL;
+    uint64_t hash = state->hash;
+    TTEntry entry;
+    Move tt_best, *tt_move = NULL;
 
-    if (entry->valid && entry->hash == hash && entry->depth >= depth) {
-        tt_hits++;
+    if (tt_probe(&t->ctx->tt, hash, &entry)) {
+        if (entry.depth >= depth) {
+            t->tt_hits++;
 
-        if (entry->flag == TT_EXACT) {
-            return entry->score;
-        }
+            if (entry.flag == TT_EXACT) {
+                return entry.score;
+            }
 
-        if (entry->flag == TT_LOWER && entry->score > alpha) {
-            alpha = entry->score;
-        }
+            if (entry.flag == TT_LOWER && entry.score > alpha) {
+                alpha = entry.score;
+            }
 
-        if (entry->flag == TT_UPPER && entry->score < beta) {
-            beta = entry->score;
-        }
+            if (entry.flag == TT_UPPER && entry.score < beta) {
+                beta = entry.score;
+            }
 
-        if (alpha >= beta) {
-            return entry->score;
+            if (alpha >= beta) {
+                return entry.score;
+            }
         }
 
-        tt_move = &entry->best_move;
-    }
-
-    // Génération et ordering des coups
-    Move moves[128];
-    int move_count = generate_legal_moves(state, moves);
-
-    if (move_count == 0) {
-        int score = base_evaluate(state, max_player);
-        return (state->current_player == max_player) ? score : -score;
+        // Même trop peu profonde, l'entrée donne un bon premier coup à essayer
+        if (entry.move != MOVE_NONE) {
+            tt_best = unpack_move(entry.move);
+            tt_move = &tt_best;
+        }
     }
 
-    int scores[128];
-    order_moves(state, moves, move_count, scores, ply, tt_move);
+    // Coups servis par étapes : la génération n'a lieu que si ni le coup de
+    // la table ni les killers n'ont coupé
+    MovePicker picker;
+    picker_init(&picker, state, tt_move, ply < MAX_DEPTH ? t->killers[ply] : NULL,
+                (const int (*)[NUM_COLORS])t->history);
 
     // Recherche avec PVS
-    Move best_move = moves[0];
+    SearchChild node, *child = &node;
+    Move best_move = {0};
     int best_score = INT_MIN;
     int original_alpha = alpha;
+    int searched = 0;
 
-    for (int i = 0; i < move_count && !time_exceeded; i++) {
-        // Appliquer le coup
-        GameState child = *state;
-        int captures = execute_move(&child, &moves[i]);
-        child.captures[child.current_player] += captures;
-        child.current_player = 1 - child.current_player;
-        child.turn_number++;
+    while (!t->time_exceeded && picker_next(&picker, child)) {
+        tt_prefetch(&t->ctx->tt, child->state.hash);
+        if (searched++ == 0) best_move = child->move;
 
         int score;
 
-        if (i == 0) {
+        if (searched == 1) {
             // Premier coup : fenêtre complète (PV move)
-            score = -negamax_pvs(&child, depth - 1, -beta, -alpha, max_player, ply + 1);
+            score = -negamax_pvs(t, &child->state, depth - 1, -beta, -alpha, ply + 1);
         } else {
             // Autres coups : zero-window search
-            score = -negamax_pvs(&child, depth - 1, -alpha - 1, -alpha, max_player, ply + 1);
+            score = -negamax_pvs(t, &child->state, depth - 1, -alpha - 1, -alpha, ply + 1);
 
             // Re-search si le score est dans [alpha, beta]
-            if (score > alpha && score < beta && !time_exceeded) {
-                re_searches++;
-                score = -negamax_pvs(&child, depth - 1, -beta, -alpha, max_player, ply + 1);
+            if (score > alpha && score < beta && !t->time_exceeded) {
+                t->re_searches++;
+                score = -negamax_pvs(t, &child->state, depth - 1, -beta, -alpha, ply + 1);
             }
         }
 
         // Mise à jour du meilleur coup
         if (score > best_score) {
             best_score = score;
-            best_move = moves[i];
+            best_move = child->move;
         }
 
         // Mise à jour alpha
@@ -231,37 +215,192 @@ static int negamax_pvs(GameState *state, int depth, int alpha, int beta,
 
         // Beta cutoff
         if (alpha >= beta) {
-            store_killer(ply, &moves[i]);
-            cutoffs++;
+            store_killer(t, ply, &child->move);
+            if (child->captured == 0) update_history(t, &child->move, depth);
+            t->cutoffs++;
             break;
         }
     }
 
-    // Stockage dans la table de transposition
-    if (!time_exceeded) {
-        entry->hash = hash;
-        entry->depth = depth;
-        entry->score = best_score;
-        entry->best_move = best_move;
-        entry->valid = 1;
+    // Aucun coup légal : position évaluée telle quelle
+    if (searched == 0 && !t->time_exceeded) {
+        int score = cached_evaluate(t->ctx, &t->eval_cache, state, max_player);
+        return (state->current_player == max_player) ? score : -score;
+    }
 
+    // Stockage dans la table de transposition
+    if (!t->time_exceeded) {
         // Déterminer le flag
+        int flag;
         if (best_score <= original_alpha) {
-            entry->flag = TT_UPPER;  // Fail-low
+            flag = TT_UPPER;  // Fail-low
         } else if (best_score >= beta) {
-            entry->flag = TT_LOWER;  // Fail-high
+            flag = TT_LOWER;  // Fail-high
         } else {
-            entry->flag = TT_EXACT;  // Exact score
+            flag = TT_EXACT;  // Exact score
         }
+
+        tt_store(&t->ctx->tt, hash, depth, best_score, flag, &best_move);
     }
 
     return best_score;
 }
 
+// ============================================================================
+// ITÉRATION À LA RACINE
+// ============================================================================
+// Renvoie 1 si l'itération à cette profondeur s'est terminée avant l'arrêt
+//
+static int search_root(SearchThread *t, int depth) {
+    GameState *pos = &t->pos;
+    int alpha = INT_MIN;
+    int beta = INT_MAX;
+    int iteration_best = INT_MIN;
+    Move iteration_move = t->root_moves[0];
+
+    // Explorer tous les coups à la racine
+    for (int i = 0; i < t->move_count && !t->time_exceeded; i++) {
+        // Appliquer le coup
+        MoveUndo undo;
+        make_move(pos, &t->root_moves[i], &undo);
+
+        int score;
+
+        if (i == 0) {
+            // Premier coup : fenêtre complète
+            score = -negamax_pvs(t, pos, depth - 1, -beta, -alpha, 1);
+        } else {
+            // Autres coups : zero-window
+            score = -negamax_pvs(t, pos, depth - 1, -alpha - 1, -alpha, 1);
+
+            if (score > alpha && score < beta && !t->time_exceeded) {
+                t->re_searches++;
+                score = -negamax_pvs(t, pos, depth - 1, -beta, -alpha, 1);
+            }
+        }
+
+        unmake_move(pos, &undo);
+
+        // Mise à jour du meilleur coup de cette itération
+        if (!t->time_exceeded && score > iteration_best) {
+            iteration_best = score;
+            iteration_move = t->root_moves[i];
+        }
+
+        // Mise à jour alpha
+        if (score > alpha) {
+            alpha = score;
+        }
+    }
+
+    // Si l'itération s'est terminée sans timeout, sauvegarder le résultat
+    if (t->time_exceeded) {
+        return 0;
+    }
+
+    t->best_score = iteration_best;
+    t->best_move = iteration_move;
+    t->completed_depth = depth;
+    t->depth_time_ms[depth] = search_elapsed_ms(t->ctx);
+
+    PvsV2Data *data = t->ctx->engine_data;
+    int known = atomic_load(&data->deepest_completed);
+    while (depth > known && !atomic_compare_exchange_weak(&data->deepest_completed, &known, depth)) {
+    }
+    return 1;
+}
+
+// ============================================================================
+// ITERATIVE DEEPENING
+// ============================================================================
+// Le thread principal parcourt toutes les profondeurs. Les aides démarrent
+// décalées (une sur deux commence à 2) et sautent les profondeurs déjà
+// terminées par un autre thread : ils remplissent la table d'entrées utiles
+// pour le principal au lieu de refaire exactement sa recherche
+//
+static void *iterative_deepening(void *arg) {
+    SearchThread *t = arg;
+    int depth = 1 + (t->id > 0 ? t->id % 2 : 0);
+
+    while (depth <= search_max_depth(t->ctx) && !t->time_exceeded) {
+        if (!search_root(t, depth)) {
+            break;
+        }
+        // Le principal seul gère le temps ; les aides s'arrêtent avec lui
+        if (t->id == 0 && !search_continue(t->ctx, &t->best_move, t->best_score)) {
+            break;
+        }
+
+        depth++;
+        if (t->id > 0) {
+            PvsV2Data *data = t->ctx->engine_data;
+            int next = atomic_load(&data->deepest_completed) + 1 + t->id % 2;
+            if (next > depth) depth = next;
+        }
+    }
+
+    // Le principal a fini (temps écoulé, limite souple ou profondeur max) : arrêter les aides
+    if (t->id == 0) {
+        atomic_store(&t->ctx->stop, 1);
+    }
+    return NULL;
+}
+
+static void init_thread(SearchThread *t, int id, SearchContext *ctx, const GameState *state,
+                        const Move *root_moves, int move_count) {
+    t->id = id;
+    t->ctx = ctx;
+    t->pos = *state;
+    t->max_player = state->current_player;
+    memcpy(t->root_moves, root_moves, move_count * sizeof(Move));
+    t->move_count = move_count;
+
+    memset(t->killers, 0, sizeof(t->killers));
+    memset(t->history, 0, sizeof(t->history));
+    t->nodes = 0;
+    t->tt_hits = 0;
+    t->tb_hits = 0;
+    t->eval_cache = (EvalCacheStats){0};
+    t->cutoffs = 0;
+    t->re_searches = 0;
+    t->time_exceeded = 0;
+
+    t->completed_depth = 0;
+    t->best_score = INT_MIN;
+    t->best_move = root_moves[0];
+    for (int d = 0; d <= MAX_DEPTH; d++) t->depth_time_ms[d] = -1;
+}
+
+// ============================================================================
+// STATISTIQUES
+// ============================================================================
+static void collect_stats(SearchContext *ctx, const SearchThread *threads, int threads_used) {
+    SearchStats *st = &ctx->stats;
+    st->threads = threads_used;
+
+    // Temps pour atteindre chaque profondeur : premier thread qui l'a terminée
+    for (int i = 0; i < threads_used; i++) {
+        const SearchThread *t = &threads[i];
+        st->nodes += t->nodes;
+        st->tt_hits += t->tt_hits;
+        st->tb_hits += t->tb_hits;
+        st->eval_cache.probes += t->eval_cache.probes;
+        st->eval_cache.hits += t->eval_cache.hits;
+        st->cutoffs += t->cutoffs;
+        st->re_searches += t->re_searches;
+        for (int d = 1; d <= MAX_DEPTH; d++) {
+            long ms = t->depth_time_ms[d];
+            if (ms >= 0 && (st->depth_time_ms[d] < 0 || ms < st->depth_time_ms[d])) {
+                st->depth_time_ms[d] = ms;
+            }
+        }
+    }
+}
+
 // ============================================================================
 // FONCTION PRINCIPALE - Iterative Deepening
 // ============================================================================
-void ai_pvs_v2_move(const GameState *state, Move *selected_move) {
+void ai_pvs_v2_move(SearchContext *ctx, const GameState *state, Move *selected_move) {
     // Génération des coups à la racine
     Move root_moves[128];
     int move_count = generate_legal_moves(state, root_moves);
@@ -271,82 +410,66 @@ void ai_pvs_v2_move(const GameState *state, Move *selected_move) {
     }
     
     // Initialisation
-    start_time = clock();
-    time_exceeded = 0;
-    nodes = 0;
-    tt_hits = 0;
-    cutoffs = 0;
-    re_searches = 0;
-    memset(killers, 0, sizeof(killers));
-    
-    // Variables de résultat
-    Move best_move = root_moves[0];
-    int best_score = INT_MIN;
-    int completed_depth = 0;
-    
-    // Ordering initial
-    int root_scores[128];
-    order_moves(state, root_moves, move_count, root_scores, 0, NULL);
-    
-    // Iterative Deepening
-    for (int depth = 1; depth <= MAX_DEPTH && !time_exceeded; depth++) {
-        int alpha = INT_MIN;
-        int beta = INT_MAX;
-        int iteration_best = INT_MIN;
-        Move iteration_move = root_moves[0];
-        
-        // Explorer tous les coups à la racine
-        for (int i = 0; i < move_count && !time_exceeded; i++) {
-            // Appliquer le coup
-            GameState child = *state;
-            int captures = execute_move(&child, &root_moves[i]);
-            child.captures[child.current_player] += captures;
-            child.current_player = 1 - child.current_player;
-            child.turn_number++;
-            
-            int score;
-            
-            if (i == 0) {
-                // Premier coup : fenêtre complète
-                score = -negamax_pvs(&child, depth - 1, -beta, -alpha, 
-                                    state->current_player, 1);
-            } else {
-                // Autres coups : zero-window
-                score = -negamax_pvs(&child, depth - 1, -alpha - 1, -alpha, 
-                                    state->current_player, 1);
-                
-                if (score > alpha && score < beta && !time_exceeded) {
-                    re_searches++;
-                    score = -negamax_pvs(&child, depth - 1, -beta, -alpha, 
-                                        state->current_player, 1);
-                }
-            }
-            
-            // Mise à jour du meilleur coup de cette itération
-            if (!time_exceeded && score > iteration_best) {
-                iteration_best = score;
-                iteration_move = root_moves[i];
-            }
-            
-            // Mise à jour alpha
-            if (score > alpha) {
-                alpha = score;
+    if (!ctx->engine_data && !(ctx->engine_data = malloc(sizeof(PvsV2Data)))) {
+        *selected_move = root_moves[0];
+        return;
+    }
+    PvsV2Data *data = ctx->engine_data;
+    SearchThread *threads = data->threads;
+    int num_threads = ctx->num_threads < 1 ? 1 :
+                      ctx->num_threads > PVS_V2_MAX_THREADS ? PVS_V2_MAX_THREADS : ctx->num_threads;
+    // L'ordonnancement des threads n'est pas reproductible
+    if (ctx->limits.deterministic) num_threads = 1;
+
+    search_start(ctx, TIME_LIMIT_MS, move_count);
+    long budget = search_node_budget(ctx);
+    long thread_budget = budget > 0 ? (budget + num_threads - 1) / num_threads : 0;
+    atomic_store(&data->deepest_completed, 0);
+
+    // Ordering initial (commun à tous les threads) : captures décroissantes
+    ChildList root_children;
+    init_thread(&threads[0], 0, ctx, state, root_moves, move_count);
+    generate_children(state, &root_children);
+    score_children(&root_children, threads[0].killers, 0, NULL, 0);
+    for (int i = 0; i < move_count; i++) root_moves[i] = next_child(&root_children)->move;
+
+    // Lancer les aides, puis chercher dans le thread courant
+    int started = 1;
+    for (int i = 0; i < num_threads; i++) {
+        init_thread(&threads[i], i, ctx, state, root_moves, move_count);
+        threads[i].node_budget = thread_budget;
+        if (i > 0) {
+            if (pthread_create(&threads[i].handle, NULL, iterative_deepening, &threads[i]) != 0) {
+                break;
             }
+            started++;
         }
-        
-        // Si l'itération s'est terminée sans timeout, sauvegarder le résultat
-        if (!time_exceeded) {
-            best_score = iteration_best;
-            best_move = iteration_move;
-            completed_depth = depth;
+    }
+
+    iterative_deepening(&threads[0]);
+
+    for (int i = 1; i < started; i++) {
+        pthread_join(threads[i].handle, NULL);
+    }
+
+    // Le principal choisit : son coup, sauf si une aide a terminé plus profond
+    const SearchThread *chosen = &threads[0];
+    for (int i = 1; i < started; i++) {
+        if (threads[i].completed_depth > chosen->completed_depth) {
+            chosen = &threads[i];
         }
     }
-    
+
+    collect_stats(ctx, threads, started);
+    search_finish(ctx);
+    ctx->stats.completed_depth = chosen->completed_depth;
+    ctx->stats.best_score = chosen->best_score;
+
     // // Affichage des statistiques
-    // long elapsed_ms = (clock() - start_time) * 1000 / CLOCKS_PER_SEC;
-    // printf("[PVS-OPT] depth=%d score=%d nodes=%d tt=%d cuts=%d re-search=%d time=%ldms\n",
-    //        completed_depth, best_score, nodes, tt_hits, cutoffs, re_searches, elapsed_ms);
-    
+    // printf("[PVS-OPT] threads=%d depth=%d score=%d nodes=%ld tt=%ld cuts=%ld re-search=%ld time=%ldms\n",
+    //        started, ctx->stats.completed_depth, ctx->stats.best_score, ctx->stats.nodes,
+    //        ctx->stats.tt_hits, ctx->stats.cutoffs, ctx->stats.re_searches, ctx->stats.elapsed_ms);
+
     // Retourner le meilleur coup trouvé
-    *selected_move = best_move;
-}
\ No newline at end of file
+    *selected_move = chosen->best_move;
+}
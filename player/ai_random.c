@@ -9,7 +9,8 @@
  * IA Random - Choisit un coup aléatoire parmi les coups légaux
  */
 
-void ai_random_move(const GameState *state, Move *selected_move) {
+void ai_random_move(SearchContext *ctx, const GameState *state, Move *selected_move) {
+    (void)ctx;
     Move legal_moves[128];  // Buffer pour stocker tous les coups légaux possibles
     int num_legal_moves = generate_legal_moves(state, legal_moves);
 
@@ -11,10 +11,13 @@
 #include "../include/ai_pvs.h"
 #include "../include/ai_aspiration.h"
 #include "../include/ai_mtdf.h"
+#include "../include/ai_common.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-void human_play(const GameState *state, Move *selected_move) {
+void human_play(SearchContext *ctx, const GameState *state, Move *selected_move) {
+    (void)ctx;
     char move_str[10];
 
     while(1) {
@@ -40,6 +43,22 @@ void human_play(const GameState *state, Move *selected_move) {
     }
 }
 
+// Chaque IA à recherche a son propre contexte : deux instances de la même IA
+// ne partagent ni table de transposition ni killers
+static SearchContext *new_context(const char *name) {
+    SearchContext *ctx = search_create();
+    if (!ctx) {
+        fprintf(stderr, "%s : allocation du contexte de recherche impossible\n", name);
+        exit(EXIT_FAILURE);
+    }
+    return ctx;
+}
+
+void destroy_player(Player *player) {
+    search_destroy(player->ctx);
+    player->ctx = NULL;
+}
+
 Player create_human_player(void) {
     Player p = {
         .play = human_play,
@@ -67,7 +86,8 @@ Player create_ai_minimax_player(void) {
 Player create_ai_alpha_beta_player(void) {
     Player p = {
         .play = ai_alpha_beta_move,
-        .name = "IA Alphabeta"
+        .name = "IA Alphabeta",
+        .ctx = new_context("IA Alphabeta")
     };
     return p;
 }
@@ -75,7 +95,8 @@ Player create_ai_alpha_beta_player(void) {
 Player create_ai_alphabeta_player(void) {
     Player p = {
         .play = ai_alphabeta_move,
-        .name = "IA Alphabeta claude"
+        .name = "IA Alphabeta claude",
+        .ctx = new_context("IA Alphabeta claude")
     };
     return p;
 }
@@ -83,7 +104,8 @@ Player create_ai_alphabeta_player(void) {
 Player create_ai_pvs_player(void) {
     Player p = {
         .play = ai_pvs_move,
-        .name = "IA PVS"
+        .name = "IA PVS",
+        .ctx = new_context("IA PVS")
     };
     return p;
 }
@@ -91,15 +113,28 @@ Player create_ai_pvs_player(void) {
 Player create_ai_pvs_v2_player(void) {
     Player p = {
         .play = ai_pvs_v2_move,
-        .name = "IA PVS V2"
+        .name = "IA PVS V2",
+        .ctx = new_context("IA PVS V2")
     };
     return p;
 }
 
+// PVS v2 avec les menaces de capture dans l'évaluation, pour les comparer en tournoi
+Player create_ai_pvs_v2_threats_player(void) {
+    Player p = {
+        .play = ai_pvs_v2_move,
+        .name = "IA PVS V2 menaces",
+        .ctx = new_context("IA PVS V2 menaces")
+    };
+    p.ctx->eval_threats = 1;
+    return p;
+}
+
 Player create_ai_mtdf_player(void) {
     Player p = {
         .play = ai_mtdf_move,
-        .name = "IA MTDF"
+        .name = "IA MTDF",
+        .ctx = new_context("IA MTDF")
     };
     return p;
 }
@@ -107,8 +142,35 @@ Player create_ai_mtdf_player(void) {
 Player create_ai_aspiration_player(void) {
     Player p = {
         .play = ai_aspiration_move,
-        .name = "IA Aspiration"
+        .name = "IA Aspiration",
+        .ctx = new_context("IA Aspiration")
     };
     return p;
 }
 
+/* ==== REGISTRE DES IA ==== */
+
+// Les IA à recherche jouent jusqu'à leur limite de temps ; ai_alpha_beta.c a la sienne
+static const PlayerInfo registry[] = {
+    { "random",     create_ai_random_player,     0 },
+    { "minimax",    create_ai_minimax_player,    10 },
+    { "alpha_beta", create_ai_alpha_beta_player, 3000 },
+    { "alphabeta",  create_ai_alphabeta_player,  TIME_LIMIT_MS },
+    { "pvs",        create_ai_pvs_player,        TIME_LIMIT_MS },
+    { "pvs_v2",     create_ai_pvs_v2_player,     TIME_LIMIT_MS },
+    { "pvs_v2_threats", create_ai_pvs_v2_threats_player, TIME_LIMIT_MS },
+    { "mtdf",       create_ai_mtdf_player,       TIME_LIMIT_MS },
+    { "aspiration", create_ai_aspiration_player, TIME_LIMIT_MS },
+};
+
+const PlayerInfo *player_registry(int *count) {
+    *count = (int)(sizeof(registry) / sizeof(registry[0]));
+    return registry;
+}
+
+const PlayerInfo *find_player(const char *id) {
+    for (size_t i = 0; i < sizeof(registry) / sizeof(registry[0]); i++) {
+        if (strcmp(registry[i].id, id) == 0) return &registry[i];
+    }
+    return NULL;
+}
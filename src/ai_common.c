@@ -1,43 +1,89 @@
 #include "../include/ai_common.h"
 
-uint64_t compute_hash(const GameState *state) {
-    uint64_t hash = 0;
-    for (int i = 0; i < NUM_HOLES; i++) {
-        hash ^= (uint64_t)(state->board[i].seeds[RED]) << (i * 3);
-        hash ^= (uint64_t)(state->board[i].seeds[BLUE]) << (i * 3 + 16);
-        hash ^= (uint64_t)(state->board[i].seeds[TRANSPARENT]) << (i * 3 + 32);
-    }
-    hash ^= (uint64_t)state->captures[0] << 48;
-    hash ^= (uint64_t)state->captures[1] << 54;
-    hash ^= (uint64_t)state->current_player << 63;
-    return hash;
+/* ==== ÉVALUATION ==== */
+
+// Victoire acquise : le score dépend du tour, il ne passe pas par le cache
+static int decided_score(const GameState *state, PlayerIndex maximizing_player, int *score) {
+    if (state->captures[maximizing_player] >= SEEDS_TO_WIN) *score = WIN_SCORE - state->turn_number;
+    else if (state->captures[1 - maximizing_player] >= SEEDS_TO_WIN) *score = -WIN_SCORE + state->turn_number;
+    else return 0;
+    return 1;
+}
+
+// Captures et plateau : ne dépend que de state->hash et du joueur (clé du cache)
+static int position_score(const GameState *state, PlayerIndex maximizing_player) {
+    int score = (state->captures[maximizing_player] - state->captures[1 - maximizing_player]) * 100;
+    PlayerIndex opp = 1 - maximizing_player;
+    const BoardSummary *summary = &state->summary;
+
+    score -= 2 * summary->singles[maximizing_player];
+    score += 5 * summary->singles[opp];
+    score += 3 * summary->capturable[opp];
+    score += (summary->seeds[maximizing_player] - summary->seeds[opp]);
+    return score;
+}
+
+// Potentiel de capture des deux joueurs, du point de vue de maximizing_player
+static int threat_score(const GameState *state, PlayerIndex maximizing_player) {
+    CapturePotential potential;
+    capture_potential(state, &potential);
+
+    PlayerIndex mover = state->current_player;
+    int mover_threat = potential.best[mover] * THREAT_MOVER_WEIGHT;
+    int waiting_threat = potential.best[1 - mover] * THREAT_WAITING_WEIGHT;
+    return mover == maximizing_player ? mover_threat - waiting_threat : waiting_threat - mover_threat;
+}
+
+static int turn_bonus(const GameState *state, PlayerIndex maximizing_player) {
+    int turns_remaining = MAX_TURNS - state->turn_number;
+    return (turns_remaining < 50 && state->captures[maximizing_player] > state->captures[1 - maximizing_player]) ? 10 : 0;
 }
 
 int base_evaluate(const GameState *state, PlayerIndex maximizing_player) {
-    int my_captures = state->captures[maximizing_player];
-    int opp_captures = state->captures[1 - maximizing_player];
-
-    if (my_captures >= SEEDS_TO_WIN) return WIN_SCORE - state->turn_number;
-    if (opp_captures >= SEEDS_TO_WIN) return -WIN_SCORE + state->turn_number;
-
-    int score = (my_captures - opp_captures) * 100;
-    int my_seeds = 0, opp_seeds = 0;
-
-    for (int i = 0; i < NUM_HOLES; i++) {
-        int total = get_total_seeds_in_hole(&state->board[i]);
-        if (is_player_hole(i, maximizing_player)) {
-            my_seeds += total;
-            if (total == 1) score -= 2;
-        } else {
-            opp_seeds += total;
-            if (total == 1) score += 5;
-            if (total == 2 || total == 3) score += 3;
-        }
+    int score;
+    if (decided_score(state, maximizing_player, &score)) return score;
+    return position_score(state, maximizing_player) + turn_bonus(state, maximizing_player);
+}
+
+int cached_evaluate(SearchContext *ctx, EvalCacheStats *stats, const GameState *state, PlayerIndex maximizing_player) {
+    int score;
+    if (decided_score(state, maximizing_player, &score)) return score;
+
+    stats->probes++;
+    uint64_t key = eval_cache_key(state, maximizing_player);
+    if (eval_cache_probe(&ctx->eval_cache, key, &score)) {
+        stats->hits++;
+    } else {
+        score = position_score(state, maximizing_player);
+        if (ctx->eval_threats) score += threat_score(state, maximizing_player);
+        eval_cache_store(&ctx->eval_cache, key, score);
     }
-    score += (my_seeds - opp_seeds);
+    return score + turn_bonus(state, maximizing_player);
+}
 
-    int turns_remaining = MAX_TURNS - state->turn_number;
-    if (turns_remaining < 50 && my_captures > opp_captures) score += 10;
+/* ==== ORDONNANCEMENT DES COUPS ==== */
 
-    return score;
+static int is_killer(SearchContext *ctx, int ply, const Move *m) {
+    if (ply >= MAX_DEPTH) return 0;
+    return same_move(&ctx->killers[ply][0], m) || same_move(&ctx->killers[ply][1], m);
+}
+
+// Coup de la table, puis killers, puis captures immédiates (tri décroissant)
+void order_moves(SearchContext *ctx, const GameState *state, Move *moves, int n, int *scores, int ply, const Move *tt_move) {
+    for (int i = 0; i < n; i++) {
+        if (tt_move && same_move(tt_move, &moves[i]))
+            scores[i] = 1000000;
+        else if (is_killer(ctx, ply, &moves[i]))
+            scores[i] = 500000;
+        else
+            scores[i] = capture_count(state, &moves[i]) * 1000;
+    }
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (scores[j] > scores[i]) {
+                int ts = scores[i]; scores[i] = scores[j]; scores[j] = ts;
+                Move tm = moves[i]; moves[i] = moves[j]; moves[j] = tm;
+            }
+        }
+    }
 }
@@ -0,0 +1,108 @@
+//
+// book.c - Lecture (mmap) et écriture du livre d'ouvertures
+//
+#include "../include/book.h"
+#include "../include/mapfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==== LECTURE ==== */
+
+static bool book_attach(Book *book, void *data, size_t size) {
+    const BookHeader *h = data;
+    if (size < sizeof(BookHeader) || memcmp(h->magic, BOOK_MAGIC, sizeof(h->magic)) != 0) return false;
+    if (h->count > (size - sizeof(BookHeader)) / sizeof(BookEntry)) return false;
+
+    book->data = data;
+    book->size = size;
+    book->entries = (const BookEntry *)(h + 1);
+    book->count = h->count;
+    return true;
+}
+
+bool book_open(Book *book, const char *path) {
+    memset(book, 0, sizeof(*book));
+
+    size_t size;
+    void *data = map_file(path, &size);
+    if (!data) return false;
+    if (!book_attach(book, data, size)) {
+        unmap_file(data, size);
+        return false;
+    }
+    return true;
+}
+
+void book_close(Book *book) {
+    unmap_file(book->data, book->size);
+    memset(book, 0, sizeof(*book));
+}
+
+bool book_probe(const Book *book, uint64_t key, BookEntry *out) {
+    size_t lo = 0, hi = book->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint64_t k = book->entries[mid].key;
+        if (k == key) {
+            *out = book->entries[mid];
+            return true;
+        }
+        if (k < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return false;
+}
+
+bool book_move(const Book *book, const GameState *state, Move *move) {
+    BookEntry e;
+    if (!book_probe(book, state->hash, &e) || e.move == MOVE_NONE) return false;
+
+    // Collision de clé ou livre d'une autre version : le coup doit être légal
+    Move legal[128];
+    int n = generate_legal_moves(state, legal);
+    for (int i = 0; i < n; i++) {
+        if (pack_move(&legal[i]) == e.move) {
+            *move = legal[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/* ==== ÉCRITURE ==== */
+
+static int compare_entries(const void *a, const void *b) {
+    const BookEntry *x = a, *y = b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    return (int)y->depth - (int)x->depth;   // Plus profonde d'abord
+}
+
+bool book_write(const char *path, BookEntry *entries, size_t count) {
+    qsort(entries, count, sizeof(BookEntry), compare_entries);
+
+    size_t unique = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (unique == 0 || entries[unique - 1].key != entries[i].key) {
+            entries[unique++] = entries[i];
+        }
+    }
+
+    char tmp[1024];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");
+    if (!f) return false;
+
+    BookHeader h;
+    memcpy(h.magic, BOOK_MAGIC, sizeof(h.magic));
+    h.count = unique;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+           && fwrite(entries, sizeof(BookEntry), unique, f) == unique;
+    ok = (fclose(f) == 0) && ok;
+
+    if (!ok || rename(tmp, path) != 0) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
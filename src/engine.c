@@ -18,7 +18,7 @@ int play_game(Player player1, Player player2, bool display) {
 
         Player *current_player = (state.current_player == PLAYER_1) ? &player1 : &player2;
 
-        current_player->play(&state, &move);
+        current_player->play(current_player->ctx, &state, &move);
 
         if (move.hole_number == -1) break; // Quit
 
@@ -27,10 +27,7 @@ int play_game(Player player1, Player player2, bool display) {
             display_move(&move);
         }
 
-        state.captures[state.current_player] += execute_move(&state, &move);
-
-        state.current_player = (state.current_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
-        state.turn_number++;
+        make_move(&state, &move, NULL);
     }
 
     if (display) {
@@ -0,0 +1,46 @@
+//
+// evalcache.c - Cache d'évaluation à accès direct, sans verrou
+//
+#include "../include/evalcache.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define EVAL_CHECK_SHIFT 16
+#define EVAL_PERSPECTIVE_KEY 0x9E3779B97F4A7C15ULL   // Évaluation pour l'adversaire du joueur au trait
+
+int eval_cache_init(EvalCache *cache, size_t size_kb) {
+    size_t bytes = size_kb * 1024;
+    size_t count = 1;
+    while (count * 2 * sizeof(uint64_t) <= bytes) count *= 2;
+
+    cache->entries = calloc(count, sizeof(uint64_t));
+    cache->mask = cache->entries ? count - 1 : 0;
+    return cache->entries != NULL;
+}
+
+void eval_cache_free(EvalCache *cache) {
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->mask = 0;
+}
+
+void eval_cache_clear(EvalCache *cache) {
+    memset(cache->entries, 0, (cache->mask + 1) * sizeof(uint64_t));
+}
+
+uint64_t eval_cache_key(const GameState *state, PlayerIndex player) {
+    return state->hash ^ (player == state->current_player ? 0 : EVAL_PERSPECTIVE_KEY);
+}
+
+// Comme la table de transposition : atomiques relâchés, un seul mot par entrée
+bool eval_cache_probe(const EvalCache *cache, uint64_t key, int *score) {
+    uint64_t entry = __atomic_load_n(&cache->entries[key & cache->mask], __ATOMIC_RELAXED);
+    if (entry == 0 || (entry >> EVAL_CHECK_SHIFT) != (key >> EVAL_CHECK_SHIFT)) return false;
+    *score = (int16_t)(uint16_t)entry;
+    return true;
+}
+
+void eval_cache_store(EvalCache *cache, uint64_t key, int score) {
+    uint64_t entry = (key >> EVAL_CHECK_SHIFT) << EVAL_CHECK_SHIFT | (uint16_t)(int16_t)score;
+    __atomic_store_n(&cache->entries[key & cache->mask], entry, __ATOMIC_RELAXED);
+}
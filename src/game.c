@@ -7,6 +7,307 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * ============================================================================
+ * OPÉRATIONS VECTORIELLES SUR LE PLATEAU
+ * ============================================================================
+ */
+
+/*
+ * Noyau de sowing : la k-ième graine semée depuis le trou h tombe toujours sur
+ * la même position d'un cycle fixe (Rouge : les 15 autres trous, Bleu : les 8
+ * trous adverses h+1, h+3, ...). n graines = n / L tours complets + un préfixe
+ * de n % L positions, ce qui donne un vecteur d'incrément de 16 octets appliqué
+ * en une addition au lieu d'une boucle graine par graine.
+ */
+
+#define SOW_RED 0
+#define SOW_BLUE 1
+
+static const int SOW_CYCLE_LEN[2] = { 15, 8 };
+static const int SOW_STEP[2] = { 1, 2 };
+
+// Bits des r premières positions du cycle, relatifs au trou h + 1
+static const uint16_t SOW_PREFIX[2][16] = {
+    { 0x0000, 0x0001, 0x0003, 0x0007, 0x000F, 0x001F, 0x003F, 0x007F,
+      0x00FF, 0x01FF, 0x03FF, 0x07FF, 0x0FFF, 0x1FFF, 0x3FFF, 0x7FFF },
+    { 0x0000, 0x0001, 0x0005, 0x0015, 0x0055, 0x0155, 0x0555, 0x1555,
+      0x5555, 0x5555, 0x5555, 0x5555, 0x5555, 0x5555, 0x5555, 0x5555 }
+};
+
+static inline unsigned rotl16(unsigned mask, int shift) {
+    shift &= 15;
+    return ((mask << shift) | (mask >> ((16 - shift) & 15))) & 0xFFFF;
+}
+
+#if defined(__SSE2__)
+typedef __m128i SeedRow;
+
+static inline SeedRow row_load(const uint8_t *row) { return _mm_loadu_si128((const __m128i *)row); }
+static inline void row_store(uint8_t *row, SeedRow r) { _mm_storeu_si128((__m128i *)row, r); }
+static inline SeedRow row_add(SeedRow a, SeedRow b) { return _mm_add_epi8(a, b); }
+static inline SeedRow row_sub(SeedRow a, SeedRow b) { return _mm_sub_epi8(a, b); }
+
+// Octets 0xFF des bits à 1 d'un masque 8 bits, partagés par toutes les
+// opérations masquées (sowing, captures, agrégats)
+#define LANE_BYTE(m, i) (((m) >> (i) & 1) ? 0xFFull << (8 * (i)) : 0)
+#define LANES8(m) (LANE_BYTE(m, 0) | LANE_BYTE(m, 1) | LANE_BYTE(m, 2) | LANE_BYTE(m, 3) | \
+                   LANE_BYTE(m, 4) | LANE_BYTE(m, 5) | LANE_BYTE(m, 6) | LANE_BYTE(m, 7))
+#define LANES4(m) LANES8(m), LANES8((m) + 1), LANES8((m) + 2), LANES8((m) + 3)
+#define LANES16(m) LANES4(m), LANES4((m) + 4), LANES4((m) + 8), LANES4((m) + 12)
+#define LANES64(m) LANES16(m), LANES16((m) + 16), LANES16((m) + 32), LANES16((m) + 48)
+
+static const uint64_t LANE_BYTES[256] = { LANES64(0), LANES64(64), LANES64(128), LANES64(192) };
+
+// 0xFF dans chaque octet dont le bit est à 1 dans mask, 0 ailleurs
+static inline SeedRow row_lanes(unsigned mask) {
+    return _mm_set_epi64x((long long)LANE_BYTES[(mask >> 8) & 0xFF], (long long)LANE_BYTES[mask & 0xFF]);
+}
+
+// value dans chaque octet dont le bit est à 1 dans mask, 0 ailleurs
+static inline SeedRow row_from_mask(unsigned mask, int value) {
+    return _mm_and_si128(row_lanes(mask), _mm_set1_epi8((char)value));
+}
+
+// Octets des trous dont le bit n'est pas dans mask
+static inline SeedRow row_clear(SeedRow r, unsigned mask) { return _mm_andnot_si128(row_lanes(mask), r); }
+static inline SeedRow row_keep(SeedRow r, unsigned mask) { return _mm_and_si128(row_lanes(mask), r); }
+
+// Bit i = octet i non nul
+static inline unsigned row_nonzero_mask(SeedRow r) {
+    return ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(r, _mm_setzero_si128())) & 0xFFFF;
+}
+
+// Bit i = octet i égal à value
+static inline unsigned row_equal_mask(SeedRow r, int value) {
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(r, _mm_set1_epi8((char)value)));
+}
+
+// Bit i = octet i égal à 2 ou 3
+static inline unsigned row_two_or_three_mask(SeedRow r) {
+    __m128i even = _mm_and_si128(r, _mm_set1_epi8((char)0xFE));
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(even, _mm_set1_epi8(2)));
+}
+
+// Somme des octets de r dont le bit est dans mask
+static inline int row_sum(SeedRow r, unsigned mask) {
+    __m128i sad = _mm_sad_epu8(row_keep(r, mask), _mm_setzero_si128());
+    return _mm_cvtsi128_si32(sad) + _mm_cvtsi128_si32(_mm_srli_si128(sad, 8));
+}
+#else
+typedef struct { uint8_t lane[NUM_HOLES]; } SeedRow;
+
+static inline SeedRow row_load(const uint8_t *row) { SeedRow r; memcpy(r.lane, row, NUM_HOLES); return r; }
+static inline void row_store(uint8_t *row, SeedRow r) { memcpy(row, r.lane, NUM_HOLES); }
+
+static inline SeedRow row_add(SeedRow a, SeedRow b) {
+    for (int i = 0; i < NUM_HOLES; i++) a.lane[i] += b.lane[i];
+    return a;
+}
+
+static inline SeedRow row_sub(SeedRow a, SeedRow b) {
+    for (int i = 0; i < NUM_HOLES; i++) a.lane[i] -= b.lane[i];
+    return a;
+}
+
+static inline SeedRow row_from_mask(unsigned mask, int value) {
+    SeedRow r;
+    for (int i = 0; i < NUM_HOLES; i++) r.lane[i] = (uint8_t)(((mask >> i) & 1) * value);
+    return r;
+}
+
+static inline SeedRow row_clear(SeedRow r, unsigned mask) {
+    for (int i = 0; i < NUM_HOLES; i++) if ((mask >> i) & 1) r.lane[i] = 0;
+    return r;
+}
+
+static inline SeedRow row_keep(SeedRow r, unsigned mask) { return row_clear(r, ~mask); }
+
+static inline unsigned row_nonzero_mask(SeedRow r) {
+    unsigned mask = 0;
+    for (int i = 0; i < NUM_HOLES; i++) mask |= (unsigned)(r.lane[i] != 0) << i;
+    return mask;
+}
+
+static inline unsigned row_equal_mask(SeedRow r, int value) {
+    unsigned mask = 0;
+    for (int i = 0; i < NUM_HOLES; i++) mask |= (unsigned)(r.lane[i] == value) << i;
+    return mask;
+}
+
+static inline unsigned row_two_or_three_mask(SeedRow r) {
+    unsigned mask = 0;
+    for (int i = 0; i < NUM_HOLES; i++) mask |= (unsigned)((r.lane[i] & 0xFE) == 2) << i;
+    return mask;
+}
+
+static inline int row_sum(SeedRow r, unsigned mask) {
+    int sum = 0;
+    for (int i = 0; i < NUM_HOLES; i++) if ((mask >> i) & 1) sum += r.lane[i];
+    return sum;
+}
+#endif
+
+// Nombre de bits à 1 en tête d'un masque 16 bits (bit 15 vers bit 0)
+static inline int leading_ones16(unsigned mask) {
+#if defined(__GNUC__)
+    return __builtin_clz(~(mask << 16));
+#else
+    int n = 0;
+    while (n < 16 && (mask & (0x8000u >> n))) n++;
+    return n;
+#endif
+}
+
+static inline int lowest_bit(unsigned mask) {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int n = 0;
+    while (!(mask & (1u << n))) n++;
+    return n;
+#endif
+}
+
+// Totaux par trou (toutes couleurs) en une addition vectorielle
+static inline SeedRow row_totals(const GameState *state) {
+    return row_add(row_add(row_load(state->seeds[RED]), row_load(state->seeds[BLUE])),
+                   row_load(state->seeds[TRANSPARENT]));
+}
+
+// Sans -mpopcnt, __builtin_popcount devient un appel à libgcc : on compte
+// alors par moitiés successives (quatre étapes pour 16 bits)
+static inline int popcount16(unsigned mask) {
+#if defined(__POPCNT__)
+    return __builtin_popcount(mask);
+#else
+    mask = mask - ((mask >> 1) & 0x5555u);
+    mask = (mask & 0x3333u) + ((mask >> 2) & 0x3333u);
+    mask = (mask + (mask >> 4)) & 0x0F0Fu;
+    return (int)((mask + (mask >> 8)) & 0x1Fu);
+#endif
+}
+
+// Recalcule les agrégats à partir des totaux par trou (quelques opérations vectorielles)
+static inline void summarize(BoardSummary *summary, SeedRow totals) {
+    unsigned capturable = row_two_or_three_mask(totals);
+    unsigned singles = row_equal_mask(totals, 1);
+
+    summary->total = (uint8_t)row_sum(totals, 0xFFFF);
+    summary->seeds[PLAYER_1] = (uint8_t)row_sum(totals, PLAYER_HOLES_MASK(PLAYER_1));
+    summary->seeds[PLAYER_2] = (uint8_t)(summary->total - summary->seeds[PLAYER_1]);
+
+    for (int p = PLAYER_1; p <= PLAYER_2; p++) {
+        unsigned own = PLAYER_HOLES_MASK(p);
+        summary->singles[p] = (uint8_t)popcount16(singles & own);
+        summary->capturable[p] = (uint8_t)popcount16(capturable & own);
+    }
+}
+
+// Incrément produit par les n premières graines semées depuis hole_index
+static inline SeedRow sow_delta(int hole_index, int stride, int n) {
+    int laps = (stride == SOW_RED) ? n / 15 : n / 8;
+    int rem = n - laps * SOW_CYCLE_LEN[stride];
+    int shift = hole_index + 1;
+    return row_add(row_from_mask(rotl16(SOW_PREFIX[stride][SOW_CYCLE_LEN[stride]], shift), laps),
+                   row_from_mask(rotl16(SOW_PREFIX[stride][rem], shift), 1));
+}
+
+// Trou de la dernière des n graines semées depuis hole_index (n >= 1 : les
+// appelants ne sèment jamais un trou vide)
+static inline int sow_last_hole(int hole_index, int stride, int n) {
+    int last = (stride == SOW_RED) ? (n - 1) % 15 : (n - 1) % 8;   // Diviseurs constants
+    return (hole_index + 1 + last * SOW_STEP[stride] + NUM_HOLES) % NUM_HOLES;
+}
+
+// Trous capturés : chaîne contiguë de trous à 2-3 graines qui remonte depuis
+// le dernier trou semé (alignée sur le bit 15 pour compter les 1 de tête)
+static inline unsigned capture_chain(unsigned capturable, int last_hole) {
+    int length = leading_ones16(rotl16(capturable, 15 - last_hole));
+    return length ? rotl16((0xFFFFu << (16 - length)) & 0xFFFF, last_hole + 1) : 0;
+}
+
+/*
+ * ============================================================================
+ * HACHAGE ZOBRIST
+ * ============================================================================
+ */
+
+// Une clé par (trou, couleur, nombre de graines), par (joueur, captures) et pour
+// le trait. La clé d'un compteur à 0 vaut 0 : un trou vide ne contribue pas.
+static uint64_t zobrist_seeds[NUM_HOLES][NUM_COLORS][TOTAL_SEEDS + 1];
+static uint64_t zobrist_captures[2][TOTAL_SEEDS + 1];
+static uint64_t zobrist_side;
+static bool zobrist_ready = false;
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Graine fixe : les mêmes clés à chaque exécution
+static void init_zobrist(void) {
+    if (zobrist_ready) return;
+
+    uint64_t seed = 0x5EED2025ULL;
+    for (int i = 0; i < NUM_HOLES; i++) {
+        for (int c = 0; c < NUM_COLORS; c++) {
+            zobrist_seeds[i][c][0] = 0;
+            for (int n = 1; n <= TOTAL_SEEDS; n++) {
+                zobrist_seeds[i][c][n] = splitmix64(&seed);
+            }
+        }
+    }
+    for (int p = PLAYER_1; p <= PLAYER_2; p++) {
+        zobrist_captures[p][0] = 0;
+        for (int n = 1; n <= TOTAL_SEEDS; n++) {
+            zobrist_captures[p][n] = splitmix64(&seed);
+        }
+    }
+    zobrist_side = splitmix64(&seed);
+    zobrist_ready = true;
+}
+
+// Différence de clé entre deux plateaux : seuls les trous modifiés sont parcourus
+static uint64_t zobrist_board_delta(const uint8_t before[NUM_COLORS][NUM_HOLES],
+                                    const uint8_t after[NUM_COLORS][NUM_HOLES]) {
+    uint64_t delta = 0;
+    for (int c = 0; c < NUM_COLORS; c++) {
+        unsigned changed = ~row_equal_mask(row_sub(row_load(after[c]), row_load(before[c])), 0) & 0xFFFF;
+        for (; changed; changed &= changed - 1) {
+            int i = lowest_bit(changed);
+            delta ^= zobrist_seeds[i][c][before[c][i]] ^ zobrist_seeds[i][c][after[c][i]];
+        }
+    }
+    return delta;
+}
+
+uint64_t compute_hash(const GameState *state) {
+    init_zobrist();   // Position reconstruite sans init_game_state (fichiers de positions)
+    uint64_t hash = 0;
+    for (int i = 0; i < NUM_HOLES; i++) {
+        for (int c = 0; c < NUM_COLORS; c++) {
+            hash ^= zobrist_seeds[i][c][state->seeds[c][i]];
+        }
+    }
+    hash ^= zobrist_captures[PLAYER_1][state->captures[PLAYER_1]];
+    hash ^= zobrist_captures[PLAYER_2][state->captures[PLAYER_2]];
+    if (state->current_player == PLAYER_2) hash ^= zobrist_side;
+    return hash;
+}
+
+uint64_t board_key(const GameState *state) {
+    return state->hash
+         ^ zobrist_captures[PLAYER_1][state->captures[PLAYER_1]]
+         ^ zobrist_captures[PLAYER_2][state->captures[PLAYER_2]];
+}
+
 /*
  * ============================================================================
  * FONCTIONS UTILITAIRES
@@ -22,56 +323,51 @@ bool is_player_hole(int hole_index, PlayerIndex playerIndex) {
         return false;
     }
 
-    int display_num = hole_display_number(hole_index);
-
-    if (playerIndex == PLAYER_1) {
-        return display_num % 2 == 1;  // Impair
-    } else {
-        return display_num % 2 == 0;  // Pair
-    }
-}
-
-int get_total_seeds_in_hole(const Hole *hole) {
-    return hole->seeds[RED] + hole->seeds[BLUE] + hole->seeds[TRANSPARENT];
+    // Joueur 1 : numéros impairs = index pairs ; Joueur 2 : l'inverse
+    return (hole_index & 1) == (int)playerIndex;
 }
 
 int get_total_seeds_on_board(const GameState *state) {
-    int total = 0;
-    for (int i = 0; i < NUM_HOLES; i++) {
-        total += get_total_seeds_in_hole(&state->board[i]);
-    }
-    return total;
+    return state->summary.total;
 }
 
-int is_valid_move(GameState *state, Move *move) {
+int is_valid_move(const GameState *state, const Move *move) {
     if (move->hole_number < 1 || move->hole_number > 16) return 0;
     if (move->hole_number % 2 == (int)state->current_player) return 0;
-    if (state->board[move->hole_number - 1].seeds[move->color] == 0) return 0;
+    if ((unsigned)move->color > TRANSPARENT) return 0;
+    if (move->color == TRANSPARENT && move->transparent_color != RED && move->transparent_color != BLUE) return 0;
+    if (state->seeds[move->color][move->hole_number - 1] == 0) return 0;
     return 1;
 }
 
 int generate_legal_moves(const GameState *state, Move *moves) {
-    int count = 0;
+    // Trous non vides par couleur (un compare par ligne), restreints au camp du joueur
+    unsigned own = PLAYER_HOLES_MASK(state->current_player);
+    unsigned red = row_nonzero_mask(row_load(state->seeds[RED])) & own;
+    unsigned blue = row_nonzero_mask(row_load(state->seeds[BLUE])) & own;
+    unsigned transparent = row_nonzero_mask(row_load(state->seeds[TRANSPARENT])) & own;
 
-    for (int i = 0; i < NUM_HOLES; i++) {
-        if (!is_player_hole(i, state->current_player)) continue;
+    int count = 0;
+    for (unsigned holes = red | blue | transparent; holes; holes &= holes - 1) {
+        int i = lowest_bit(holes);
+        unsigned bit = 1u << i;
 
         // Rouge
-        if (state->board[i].seeds[RED] > 0) {
+        if (red & bit) {
             moves[count].hole_number = i + 1;  // Numéro d'affichage
             moves[count].color = RED;
             count++;
         }
 
         // Bleu
-        if (state->board[i].seeds[BLUE] > 0) {
+        if (blue & bit) {
             moves[count].hole_number = i + 1;
             moves[count].color = BLUE;
             count++;
         }
 
         // Transparent comme Rouge
-        if (state->board[i].seeds[TRANSPARENT] > 0) {
+        if (transparent & bit) {
             moves[count].hole_number = i + 1;
             moves[count].color = TRANSPARENT;
             moves[count].transparent_color = RED;
@@ -95,7 +391,7 @@ int is_game_over(const GameState *state) {
     }
 
     // Vérifie s'il reste moins de 10 graines sur le plateau
-    if (get_total_seeds_on_board(state) < 10) {
+    if (state->summary.total < 10) {
         return 1;
     }
 
@@ -115,22 +411,26 @@ int is_game_over(const GameState *state) {
 void init_game_state(GameState *state) {
     memset(state, 0, sizeof(GameState));
 
-    for (int i = 0; i < NUM_HOLES; i++) {
-        state->board[i].seeds[RED] = 2;
-        state->board[i].seeds[BLUE] = 2;
-        state->board[i].seeds[TRANSPARENT] = 2;
-    }
+    memset(state->seeds, 2, sizeof(state->seeds));
 
     state->captures[PLAYER_1] = 0;
     state->captures[PLAYER_2] = 0;
     state->current_player = PLAYER_1;
     state->turn_number = 1;
+    update_board_summary(state);
+
+    init_zobrist();
+    state->hash = compute_hash(state);
 }
 
 void copy_game_state(const GameState *source, GameState *dest) {
     memcpy(dest, source, sizeof(GameState));
 }
 
+void update_board_summary(GameState *state) {
+    summarize(&state->summary, row_totals(state));
+}
+
 int parse_move(char *move_str, Move *move) {
     int len = strlen(move_str);
     if (len < 2 || len > 4) return 0;
@@ -197,9 +497,9 @@ void display_game_state(const GameState *state) {
     for (int i = 0; i < NUM_HOLES; i++) {
         printf("| %2d (%dR %dB %dT) ",
                hole_display_number(i),
-               state->board[i].seeds[RED],
-               state->board[i].seeds[BLUE],
-               state->board[i].seeds[TRANSPARENT]);
+               state->seeds[RED][i],
+               state->seeds[BLUE][i],
+               state->seeds[TRANSPARENT][i]);
 
         if ((i + 1) % 4 == 0) {
             printf("|\n");
@@ -233,61 +533,291 @@ void display_move(const Move *move) {
  * ============================================================================
 */
 
-int execute_move(GameState *state, Move *move) {
-    // Sowing
+// Incréments des graines transparentes et des graines de la couleur semées
+// depuis hole_index (les transparentes d'abord) ; renvoie le dernier trou semé
+static inline int sow_rows(int hole_index, Color color, int nbSeedsTransparent, int nbSeeds,
+                           SeedRow *transparent_delta, SeedRow *color_delta) {
+    int stride = (color == RED) ? SOW_RED : SOW_BLUE;
+    int total = nbSeedsTransparent + nbSeeds;
+
+    SeedRow all = sow_delta(hole_index, stride, total);
+    *transparent_delta = nbSeedsTransparent ? sow_delta(hole_index, stride, nbSeedsTransparent)
+                                            : row_from_mask(0, 0);
+    *color_delta = row_sub(all, *transparent_delta);
+    return sow_last_hole(hole_index, stride, total);
+}
+
+// Agrégats d'un trou passé de before à after graines
+static inline void summary_update(BoardSummary *summary, int hole_index, int before, int after) {
+    summary->total = (uint8_t)(summary->total + after - before);
+    int p = hole_index & 1;   // Index pair : PLAYER_1
+    summary->seeds[p] = (uint8_t)(summary->seeds[p] + after - before);
+    summary->singles[p] = (uint8_t)(summary->singles[p] + (after == 1) - (before == 1));
+    summary->capturable[p] = (uint8_t)(summary->capturable[p] + ((after & ~1) == 2) - ((before & ~1) == 2));
+}
+
+// Sowing court (au plus un tour du cycle, chaque trou reçoit au plus une graine) :
+// graine par graine, la clé et les agrégats (full) suivant chaque trou touché.
+// C'est le cas courant en milieu de partie, où la boucle coûte moins que le
+// noyau vectoriel
+static inline int sow_short(GameState *state, int hole_index, Color color, int nbSeedsTransparent, int nbSeeds,
+                     int step, MoveUndo *undo, bool full) {
+    uint64_t hash = 0;
+    if (full) {
+        int start_total = get_total_seeds_in_hole(state, hole_index);
+        summary_update(&state->summary, hole_index, start_total, start_total - nbSeedsTransparent - nbSeeds);
+        hash ^= zobrist_seeds[hole_index][TRANSPARENT][state->seeds[TRANSPARENT][hole_index]]
+              ^ zobrist_seeds[hole_index][TRANSPARENT][state->seeds[TRANSPARENT][hole_index] - nbSeedsTransparent]
+              ^ zobrist_seeds[hole_index][color][nbSeeds];
+    }
+    state->seeds[TRANSPARENT][hole_index] = (uint8_t)(state->seeds[TRANSPARENT][hole_index] - nbSeedsTransparent);
+    state->seeds[color][hole_index] = 0;
+
+    // Les transparentes d'abord, depuis le trou suivant, de step en step
+    unsigned hole = (unsigned)(hole_index + NUM_HOLES + 1 - step);
+    for (int k = 0; k < nbSeedsTransparent + nbSeeds; k++) {
+        hole = (hole + (unsigned)step) % NUM_HOLES;
+        Color c = (k < nbSeedsTransparent) ? TRANSPARENT : color;
+        if (full) {
+            int total = get_total_seeds_in_hole(state, (int)hole);
+            summary_update(&state->summary, (int)hole, total, total + 1);
+            hash ^= zobrist_seeds[hole][c][state->seeds[c][hole]] ^ zobrist_seeds[hole][c][state->seeds[c][hole] + 1];
+        }
+        state->seeds[c][hole]++;
+    }
+
+    // Capturing : trous à 2-3 graines en remontant depuis le dernier trou semé
+    int captured = 0;
+    unsigned chain = 0;
+    for (;;) {
+        int total = get_total_seeds_in_hole(state, (int)hole);
+        if (total != 2 && total != 3) break;
+        if (undo && !chain) memset(undo->captured, 0, sizeof(undo->captured));
+        chain |= 1u << hole;
+        for (int c = 0; c < NUM_COLORS; c++) {
+            int n = state->seeds[c][hole];
+            if (undo) undo->captured[c][hole] = (uint8_t)n;
+            if (full) hash ^= zobrist_seeds[hole][c][n];
+            state->seeds[c][hole] = 0;
+        }
+        if (full) summary_update(&state->summary, (int)hole, total, 0);
+        captured += total;
+        hole = (hole + NUM_HOLES - 1) % NUM_HOLES;
+    }
+
+    if (undo) undo->captured_mask = (uint16_t)chain;
+    if (full) state->hash ^= hash;
+    else state->summary.total = (uint8_t)(state->summary.total - captured);
+    return captured;
+}
+
+// Sowing + capture. Si undo != NULL, y consigne de quoi annuler le plateau.
+// full : clé Zobrist et agrégats tenus à jour ; sinon seul summary.total l'est
+// (make_move_bare). Un sowing qui boucle le cycle passe par le noyau vectoriel :
+// les trois lignes sont chargées une fois et rangées une fois, aucun octet
+// écrit seul puis relu en ligne (blocage de la redirection des écritures)
+static int sow_and_capture(GameState *state, const Move *move, MoveUndo *undo, bool full) {
     int hole_index = move->hole_number - 1;  // Convertir numéro (1-16) en index (0-15)
 
     bool transparent = (move->color == TRANSPARENT);
-    Color color = move->color;
-    int nbSeedsTransparent = 0;
-    if (transparent) {
-        color = move->transparent_color;
-        nbSeedsTransparent = state->board[hole_index].seeds[TRANSPARENT];
-        state->board[hole_index].seeds[TRANSPARENT] = 0;
+    Color color = transparent ? move->transparent_color : move->color;
+    int stride = (color == RED) ? SOW_RED : SOW_BLUE;
+    int nbSeedsTransparent = transparent ? state->seeds[TRANSPARENT][hole_index] : 0;
+    int nbSeeds = state->seeds[color][hole_index];
+
+    if (undo) {
+        undo->hole = (uint8_t)hole_index;
+        undo->color = (uint8_t)color;
+        undo->sown_transparent = (uint8_t)nbSeedsTransparent;
+        undo->sown_colored = (uint8_t)nbSeeds;
     }
-    int nbSeeds = state->board[hole_index].seeds[color];
-    state->board[hole_index].seeds[color] = 0;
 
-    // Commencer au trou suivant
-    int indexHole = (hole_index + 1) % NUM_HOLES;
+    if (nbSeedsTransparent + nbSeeds <= SOW_CYCLE_LEN[stride]) {
+        return sow_short(state, hole_index, color, nbSeedsTransparent, nbSeeds, SOW_STEP[stride], undo, full);
+    }
 
-    while(nbSeedsTransparent + nbSeeds > 0) {
-        if (indexHole == hole_index) {
-            // Sauter le trou de départ
-            indexHole = (indexHole + (color == RED ? 1 : 2)) % NUM_HOLES;
-            continue;
-        }
+    uint8_t before[NUM_COLORS][NUM_HOLES];
+    if (full) memcpy(before, state->seeds, sizeof(before));
 
-        // Déposer une graine
-        if (nbSeedsTransparent > 0) {
-            state->board[indexHole].seeds[TRANSPARENT]++;
-            nbSeedsTransparent--;
-        } else {
-            state->board[indexHole].seeds[color]++;
-            nbSeeds--;
+    unsigned start = 1u << hole_index;
+    SeedRow rows[NUM_COLORS], transparent_delta, color_delta;
+    for (int c = 0; c < NUM_COLORS; c++) rows[c] = row_load(state->seeds[c]);
+    int indexHole = sow_rows(hole_index, color, nbSeedsTransparent, nbSeeds, &transparent_delta, &color_delta);
+
+    // Trou de départ vidé, puis sowing en une addition par ligne
+    if (transparent) rows[TRANSPARENT] = row_add(row_clear(rows[TRANSPARENT], start), transparent_delta);
+    rows[color] = row_add(row_clear(rows[color], start), color_delta);
+
+    // Capturing : trous à 2-3 graines en un masque, puis chaîne depuis le dernier trou semé
+    SeedRow totals = row_add(row_add(rows[RED], rows[BLUE]), rows[TRANSPARENT]);
+    unsigned chain = capture_chain(row_two_or_three_mask(totals), indexHole);
+
+    if (undo) {
+        undo->captured_mask = (uint16_t)chain;
+    }
+    int captured = 0;
+    if (chain) {
+        for (int c = 0; c < NUM_COLORS; c++) {
+            if (undo) row_store(undo->captured[c], row_keep(rows[c], chain));
+            rows[c] = row_clear(rows[c], chain);
         }
+        captured = row_sum(totals, chain);
+        totals = row_clear(totals, chain);
+    }
 
-        // Avancer au trou suivant (Rouge: +1, Bleu: +2)
-        indexHole = (indexHole + (color == RED ? 1 : 2)) % NUM_HOLES;
+    for (int c = 0; c < NUM_COLORS; c++) row_store(state->seeds[c], rows[c]);
+    if (full) {
+        summarize(&state->summary, totals);
+        state->hash ^= zobrist_board_delta(before, state->seeds);
+    } else {
+        state->summary.total = (uint8_t)(state->summary.total - captured);
     }
+    return captured;
+}
 
-    // Revenir au dernier trou où on a déposé (on a avancé une fois de trop)
-    indexHole = (indexHole - (color == RED ? 1 : 2) + NUM_HOLES) % NUM_HOLES;
+int execute_move(GameState *state, Move *move) {
+    return sow_and_capture(state, move, NULL, true);
+}
 
-    //Capturing
+static inline void save_undo(const GameState *state, MoveUndo *undo) {
+    undo->captures[PLAYER_1] = state->captures[PLAYER_1];
+    undo->captures[PLAYER_2] = state->captures[PLAYER_2];
+    undo->current_player = state->current_player;
+    undo->summary = state->summary;
+    undo->turn_number = state->turn_number;
+    undo->hash = state->hash;
+}
 
-    int seedsCaptured = 0;
-    while (true) {
-        int totalSeedsHole = get_total_seeds_in_hole(&state->board[indexHole]);
-        if (totalSeedsHole == 2 || totalSeedsHole == 3) {
-            seedsCaptured += totalSeedsHole;
-            state->board[indexHole].seeds[RED] = 0;
-            state->board[indexHole].seeds[BLUE] = 0;
-            state->board[indexHole].seeds[TRANSPARENT] = 0;
-            indexHole = (indexHole - 1 + NUM_HOLES) % NUM_HOLES;
-        } else {
-            break;
+int make_move(GameState *state, const Move *move, MoveUndo *undo) {
+    if (undo) save_undo(state, undo);
+
+    int captured = sow_and_capture(state, move, undo, true);
+
+    PlayerIndex mover = state->current_player;
+    state->hash ^= zobrist_captures[mover][state->captures[mover]];
+    state->captures[mover] += captured;
+    state->hash ^= zobrist_captures[mover][state->captures[mover]] ^ zobrist_side;
+    state->current_player = 1 - mover;
+    state->turn_number++;
+    return captured;
+}
+
+int make_move_bare(GameState *state, const Move *move) {
+    int captured = sow_and_capture(state, move, NULL, false);
+    state->captures[state->current_player] += captured;
+    state->current_player = 1 - state->current_player;
+    state->turn_number++;
+    return captured;
+}
+
+void make_null_move(GameState *state) {
+    state->current_player = 1 - state->current_player;
+    state->hash ^= zobrist_side;
+}
+
+void unmake_move(GameState *state, const MoveUndo *undo) {
+    SeedRow rows[NUM_COLORS];
+    for (int c = 0; c < NUM_COLORS; c++) rows[c] = row_load(state->seeds[c]);
+
+    // Remettre les trous capturés tels qu'ils étaient après le sowing
+    if (undo->captured_mask) {
+        for (int c = 0; c < NUM_COLORS; c++) rows[c] = row_add(rows[c], row_load(undo->captured[c]));
+    }
+
+    // Retirer les graines semées et les rendre au trou de départ
+    Color color = (Color)undo->color;
+    unsigned start = 1u << undo->hole;
+    SeedRow transparent_delta, color_delta;
+    sow_rows(undo->hole, color, undo->sown_transparent, undo->sown_colored, &transparent_delta, &color_delta);
+    rows[TRANSPARENT] = row_add(row_sub(rows[TRANSPARENT], transparent_delta),
+                                row_from_mask(start, undo->sown_transparent));
+    rows[color] = row_add(row_sub(rows[color], color_delta), row_from_mask(start, undo->sown_colored));
+    for (int c = 0; c < NUM_COLORS; c++) row_store(state->seeds[c], rows[c]);
+
+    state->captures[PLAYER_1] = undo->captures[PLAYER_1];
+    state->captures[PLAYER_2] = undo->captures[PLAYER_2];
+    state->current_player = undo->current_player;
+    state->summary = undo->summary;
+    state->turn_number = undo->turn_number;
+    state->hash = undo->hash;
+}
+
+/*
+ * ============================================================================
+ * POTENTIEL DE CAPTURE
+ * ============================================================================
+ * Seul le total par trou décide d'une capture : un coup se résume à (trou,
+ * cycle, graines semées). Le plateau après sowing est la ligne des totaux moins
+ * le trou vidé plus l'incrément du cycle (sow_delta), et la chaîne se lit sur
+ * le masque vectoriel des trous à 2-3 graines. Ni copie de la position, ni
+ * clé, ni agrégats : quelques opérations sur 16 octets par coup.
+ */
+
+// Graines capturées en semant n graines du trou hole_index
+static inline int sow_captures(SeedRow totals, int hole_index, int stride, int n) {
+    SeedRow after = row_add(row_sub(totals, row_from_mask(1u << hole_index, n)), sow_delta(hole_index, stride, n));
+    unsigned chain = capture_chain(row_two_or_three_mask(after), sow_last_hole(hole_index, stride, n));
+    return chain ? row_sum(after, chain) : 0;
+}
+
+static inline void add_capture(Move *moves, uint8_t *captures, int *count, int *best,
+                               int hole_index, Color color, Color real, int captured) {
+    if (moves) {
+        moves[*count].hole_number = hole_index + 1;
+        moves[*count].color = color;
+        moves[*count].transparent_color = real;
+    }
+    captures[(*count)++] = (uint8_t)captured;
+    if (captured > *best) *best = captured;
+}
+
+// Coups de player dans l'ordre de generate_legal_moves, totaux déjà calculés
+static int player_captures(const GameState *state, SeedRow totals, PlayerIndex player,
+                           Move *moves, uint8_t *captures, int *best) {
+    int count = 0;
+    *best = 0;
+    for (unsigned holes = row_nonzero_mask(totals) & PLAYER_HOLES_MASK(player); holes; holes &= holes - 1) {
+        int i = lowest_bit(holes);
+        int red = state->seeds[RED][i];
+        int blue = state->seeds[BLUE][i];
+        int transparent = state->seeds[TRANSPARENT][i];
+
+        if (red) add_capture(moves, captures, &count, best, i, RED, RED, sow_captures(totals, i, SOW_RED, red));
+        if (blue) add_capture(moves, captures, &count, best, i, BLUE, BLUE, sow_captures(totals, i, SOW_BLUE, blue));
+        if (transparent) {
+            add_capture(moves, captures, &count, best, i, TRANSPARENT, RED,
+                        sow_captures(totals, i, SOW_RED, transparent + red));
+            add_capture(moves, captures, &count, best, i, TRANSPARENT, BLUE,
+                        sow_captures(totals, i, SOW_BLUE, transparent + blue));
         }
     }
-    return seedsCaptured;
-}
\ No newline at end of file
+    return count;
+}
+
+int move_captures(const GameState *state, PlayerIndex player, Move *moves, uint8_t *captures) {
+    int best;
+    return player_captures(state, row_totals(state), player, moves, captures, &best);
+}
+
+int best_capture(const GameState *state, PlayerIndex player) {
+    uint8_t captures[MAX_LEGAL_MOVES];
+    int best;
+    player_captures(state, row_totals(state), player, NULL, captures, &best);
+    return best;
+}
+
+void capture_potential(const GameState *state, CapturePotential *potential) {
+    SeedRow totals = row_totals(state);
+    for (int p = PLAYER_1; p <= PLAYER_2; p++) {
+        potential->count[p] = player_captures(state, totals, (PlayerIndex)p, potential->moves[p],
+                                              potential->captures[p], &potential->best[p]);
+    }
+}
+
+int capture_count(const GameState *state, const Move *move) {
+    int hole_index = move->hole_number - 1;
+    Color color = (move->color == TRANSPARENT) ? move->transparent_color : move->color;
+    int n = state->seeds[color][hole_index];
+    if (move->color == TRANSPARENT) n += state->seeds[TRANSPARENT][hole_index];
+    return sow_captures(row_totals(state), hole_index, color == RED ? SOW_RED : SOW_BLUE, n);
+}
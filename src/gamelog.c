@@ -0,0 +1,134 @@
+//
+// gamelog.c - Lecture (mmap), rejeu et écriture des parties enregistrées
+//
+#include "../include/gamelog.h"
+#include "../include/mapfile.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define GAMELOG_ALIGN 8
+#define WRITER_BUFFER_SIZE (1 << 20)
+
+static uint64_t game_size(const GameLogGame *game) {
+    uint64_t size = sizeof(GameLogGame) + game->move_count;
+    return (size + GAMELOG_ALIGN - 1) & ~(uint64_t)(GAMELOG_ALIGN - 1);
+}
+
+/* ==== LECTURE ==== */
+
+bool gamelog_open(GameLogFile *file, const char *path) {
+    memset(file, 0, sizeof(*file));
+
+    size_t size;
+    void *data = map_file(path, &size);
+    if (!data) return false;
+
+    const GameLogHeader *h = data;
+    bool valid = size >= sizeof(GameLogHeader)
+              && memcmp(h->magic, GAMELOG_MAGIC, sizeof(h->magic)) == 0
+              && h->index_offset % GAMELOG_ALIGN == 0
+              && h->index_offset <= size
+              && h->count <= (size - h->index_offset) / sizeof(uint64_t);
+    if (!valid) {
+        unmap_file(data, size);
+        return false;
+    }
+
+    file->data = data;
+    file->size = size;
+    file->offsets = (const uint64_t *)((const char *)data + h->index_offset);
+    file->count = h->count;
+    file->games_end = h->index_offset;
+    return true;
+}
+
+void gamelog_close(GameLogFile *file) {
+    unmap_file(file->data, file->size);
+    memset(file, 0, sizeof(*file));
+}
+
+// Vérifiée à chaque accès plutôt qu'à l'ouverture : ouvrir un gros fichier
+// ne lit que son en-tête
+const GameLogGame *gamelog_game(const GameLogFile *file, size_t i) {
+    if (i >= file->count) return NULL;
+
+    uint64_t o = file->offsets[i];
+    if (o % GAMELOG_ALIGN != 0 || o < sizeof(GameLogHeader) || o + sizeof(GameLogGame) > file->games_end) return NULL;
+    const GameLogGame *game = (const GameLogGame *)((const char *)file->data + o);
+    return o + game_size(game) <= file->games_end ? game : NULL;
+}
+
+int gamelog_replay(const GameLogGame *game, int ply, GameState *state) {
+    if (ply < 0 || ply > game->move_count) ply = game->move_count;
+
+    init_game_state(state);
+    const uint8_t *moves = gamelog_moves(game);
+    for (int i = 0; i < ply; i++) {
+        Move move = unpack_move(moves[i]);
+        make_move(state, &move, NULL);
+    }
+    return ply;
+}
+
+/* ==== ÉCRITURE ==== */
+
+bool gamelog_writer_open(GameLogWriter *w, const char *path) {
+    memset(w, 0, sizeof(*w));
+    snprintf(w->path, sizeof(w->path), "%s", path);
+
+    char tmp[1040];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    w->file = fopen(tmp, "wb");
+    if (!w->file) return false;
+    setvbuf(w->file, NULL, _IOFBF, WRITER_BUFFER_SIZE);
+
+    // En-tête provisoire, réécrit à la fermeture
+    GameLogHeader h = {0};
+    w->position = sizeof(h);
+    return fwrite(&h, sizeof(h), 1, w->file) == 1;
+}
+
+bool gamelog_writer_add(GameLogWriter *w, const GameLogGame *game, const uint8_t *moves) {
+    if (w->count == w->cap) {
+        size_t cap = w->cap ? w->cap * 2 : 1024;
+        uint64_t *grown = realloc(w->offsets, cap * sizeof(uint64_t));
+        if (!grown) return false;
+        w->offsets = grown;
+        w->cap = cap;
+    }
+
+    static const uint8_t padding[GAMELOG_ALIGN] = {0};
+    uint64_t size = game_size(game);
+    size_t pad = size - sizeof(GameLogGame) - game->move_count;
+    bool ok = fwrite(game, sizeof(GameLogGame), 1, w->file) == 1
+           && fwrite(moves, 1, game->move_count, w->file) == game->move_count
+           && fwrite(padding, 1, pad, w->file) == pad;
+    if (!ok) return false;
+
+    w->offsets[w->count++] = w->position;
+    w->position += size;
+    return true;
+}
+
+bool gamelog_writer_close(GameLogWriter *w) {
+    char tmp[1040];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", w->path);
+    bool ok = w->file != NULL;
+
+    if (ok) {
+        GameLogHeader h = { .count = w->count, .index_offset = w->position };
+        memcpy(h.magic, GAMELOG_MAGIC, sizeof(h.magic));
+        ok = fwrite(w->offsets, sizeof(uint64_t), w->count, w->file) == w->count
+          && fseek(w->file, 0, SEEK_SET) == 0
+          && fwrite(&h, sizeof(h), 1, w->file) == 1;
+        ok = (fclose(w->file) == 0) && ok;
+    }
+
+    if (!ok || rename(tmp, w->path) != 0) {
+        remove(tmp);
+        ok = false;
+    }
+    free(w->offsets);
+    memset(w, 0, sizeof(*w));
+    return ok;
+}
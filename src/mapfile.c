@@ -0,0 +1,57 @@
+//
+// mapfile.c - Projection en mémoire des fichiers de données (livre, finales)
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/mapfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+void *map_file(const char *path, size_t *size) {
+#ifdef _WIN32
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    void *data = len > 0 ? malloc(len) : NULL;
+    if (data && fread(data, 1, len, f) != (size_t)len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = data ? (size_t)len : 0;
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void *data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    *size = st.st_size;
+    return data;
+#endif
+}
+
+void unmap_file(void *data, size_t size) {
+    if (!data) return;
+#ifdef _WIN32
+    (void)size;
+    free(data);
+#else
+    munmap(data, size);
+#endif
+}
@@ -0,0 +1,189 @@
+//
+// match.c - Pool de workers pour les tournois et simulations
+//
+// Chaque partie est jouée dans un processus fils : les IA y sont créées avec
+// leur propre contexte, rand() y a sa propre graine, et un plantage n'emporte
+// que la partie concernée. Le résultat remonte par le code de sortie.
+//
+#define _GNU_SOURCE
+
+#include "../include/match.h"
+#include "../include/engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <sched.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+/* ==== UTILITAIRES ==== */
+
+unsigned int match_game_seed(unsigned int base_seed, int index) {
+    // Mélange de Knuth : graines voisines bien séparées
+    return base_seed ^ ((unsigned int)(index + 1) * 2654435761u);
+}
+
+int match_default_workers(void) {
+#ifdef _WIN32
+    return 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+static int game_cost(const MatchGame *g) {
+    return g->player1->move_cost_ms + g->player2->move_cost_ms;
+}
+
+// Tri par insertion stable, du plus coûteux au moins coûteux
+static void sort_by_cost_desc(int *order, int count, const MatchGame *games) {
+    for (int i = 1; i < count; i++) {
+        int idx = order[i], cost = game_cost(&games[idx]);
+        int j = i - 1;
+        while (j >= 0 && game_cost(&games[order[j]]) < cost) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = idx;
+    }
+}
+
+// Joue une partie dans le processus courant
+static int play_one(const MatchGame *g, bool verbose) {
+    srand(g->seed);
+
+    Player p1 = g->player1->create();
+    Player p2 = g->player2->create();
+    if (p1.ctx) { p1.ctx->num_threads = g->threads; p1.ctx->limits = g->limits; }
+    if (p2.ctx) { p2.ctx->num_threads = g->threads; p2.ctx->limits = g->limits; }
+
+    int winner = play_game(p1, p2, verbose);
+
+    destroy_player(&p1);
+    destroy_player(&p2);
+    return winner;
+}
+
+/* ==== POOL DE WORKERS ==== */
+
+#ifndef _WIN32
+static void pin_to_core(int slot) {
+#ifdef __linux__
+    int cores = match_default_workers();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(slot % cores, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)slot;
+#endif
+}
+
+// Code de sortie du fils : 0 = joueur 1, 1 = joueur 2, 2 = nul
+static int encode_result(int winner) {
+    return winner == PLAYER_1 ? 0 : winner == PLAYER_2 ? 1 : 2;
+}
+
+static int decode_status(int status) {
+    if (!WIFEXITED(status)) return MATCH_ERROR;
+    switch (WEXITSTATUS(status)) {
+        case 0: return PLAYER_1;
+        case 1: return PLAYER_2;
+        case 2: return -1;
+        default: return MATCH_ERROR;
+    }
+}
+#endif
+
+int run_match_games(MatchGame *games, int count, int workers, bool verbose,
+                    MatchCallback done, void *user) {
+    if (count <= 0) return 0;
+
+    // Les parties les plus longues d'abord : la fin du tournoi n'attend pas
+    // une seule paire lente pendant que les autres cœurs sont libres
+    int *order = malloc(count * sizeof(int));
+    if (!order) return 0;
+    for (int i = 0; i < count; i++) order[i] = i;
+    sort_by_cost_desc(order, count, games);
+
+#ifdef _WIN32
+    workers = 1;
+#endif
+
+    int played = 0;
+    bool keep_going = true;
+
+    if (workers <= 1) {
+        for (int k = 0; k < count && keep_going; k++) {
+            MatchGame *g = &games[order[k]];
+            g->result = play_one(g, verbose);
+            played++;
+            if (done) keep_going = done(g, user);
+        }
+        free(order);
+        return played;
+    }
+
+#ifndef _WIN32
+    if (workers > count) workers = count;
+    pid_t *slot_pid = calloc(workers, sizeof(pid_t));
+    int *slot_game = calloc(workers, sizeof(int));
+    if (!slot_pid || !slot_game) {
+        free(slot_pid);
+        free(slot_game);
+        free(order);
+        return 0;
+    }
+
+    int next = 0, running = 0;
+    while ((next < count && keep_going) || running > 0) {
+        // Remplir les slots libres
+        for (int s = 0; s < workers && next < count && keep_going; s++) {
+            if (slot_pid[s] != 0) continue;
+
+            int gi = order[next++];
+            fflush(stdout);
+            pid_t pid = fork();
+            if (pid == 0) {
+                pin_to_core(s);
+                int winner = play_one(&games[gi], verbose);
+                fflush(stdout);
+                _exit(encode_result(winner));
+            }
+            if (pid < 0) {
+                games[gi].result = MATCH_ERROR;
+                played++;
+                if (done) keep_going = done(&games[gi], user);
+                continue;
+            }
+            slot_pid[s] = pid;
+            slot_game[s] = gi;
+            running++;
+        }
+
+        // Attendre la fin d'une partie
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0) break;
+        for (int s = 0; s < workers; s++) {
+            if (slot_pid[s] != pid) continue;
+            MatchGame *g = &games[slot_game[s]];
+            g->result = decode_status(status);
+            slot_pid[s] = 0;
+            running--;
+            played++;
+            if (done && !done(g, user)) keep_going = false;
+            break;
+        }
+    }
+
+    free(slot_pid);
+    free(slot_game);
+#endif
+    free(order);
+    return played;
+}
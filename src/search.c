@@ -0,0 +1,402 @@
+//
+// search.c - Cycle de vie du contexte de recherche
+//
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/search.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+SearchContext *search_create(void) {
+    SearchContext *ctx = calloc(1, sizeof(SearchContext));
+    if (!ctx) return NULL;
+
+    if (!tt_init(&ctx->tt, tt_default_size_mb())) {
+        free(ctx);
+        return NULL;
+    }
+    if (!eval_cache_init(&ctx->eval_cache, EVAL_CACHE_DEFAULT_SIZE_KB)) {
+        tt_free(&ctx->tt);
+        free(ctx);
+        return NULL;
+    }
+    atomic_init(&ctx->stop, 0);
+    ctx->num_threads = 1;
+
+    // Attente du minuteur sur l'horloge monotone, comme search_elapsed_ms
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&ctx->time.wake, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&ctx->time.lock, NULL);
+    return ctx;
+}
+
+void search_destroy(SearchContext *ctx) {
+    if (!ctx) return;
+    pthread_cond_destroy(&ctx->time.wake);
+    pthread_mutex_destroy(&ctx->time.lock);
+    tt_free(&ctx->tt);
+    eval_cache_free(&ctx->eval_cache);
+    free(ctx->engine_data);
+    free(ctx);
+}
+
+void search_clear(SearchContext *ctx) {
+    tt_clear(&ctx->tt);
+    eval_cache_clear(&ctx->eval_cache);
+    memset(ctx->killers, 0, sizeof(ctx->killers));
+    memset(ctx->history, 0, sizeof(ctx->history));
+    ctx->time.bank_ms = 0;
+}
+
+/* ==== MINUTEUR ==== */
+
+// Dort jusqu'à la limite dure puis lève ctx->stop ; search_finish le réveille
+// plus tôt quand la recherche se termine d'elle-même
+static void *timer_main(void *arg) {
+    SearchContext *ctx = arg;
+    TimeManager *tm = &ctx->time;
+
+    pthread_mutex_lock(&tm->lock);
+    long ms = tm->origin_ms + tm->hard_ms;
+    struct timespec deadline = ctx->start_time;
+    deadline.tv_sec += ms / 1000;
+    deadline.tv_nsec += (ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (tm->timer_running) {
+        if (pthread_cond_timedwait(&tm->wake, &tm->lock, &deadline) == ETIMEDOUT) {
+            atomic_store(&ctx->stop, 1);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&tm->lock);
+    return NULL;
+}
+
+// Verrou tenu
+static void start_timer(SearchContext *ctx) {
+    TimeManager *tm = &ctx->time;
+    tm->timer_running = 1;
+    if (pthread_create(&tm->timer, NULL, timer_main, ctx) != 0) {
+        // Pas de minuteur : search_continue arrêtera au moins à la limite souple
+        tm->timer_running = 0;
+    }
+}
+
+/* ==== CYCLE D'UN COUP ==== */
+
+static void set_budget(SearchContext *ctx, long default_time_ms) {
+    TimeManager *tm = &ctx->time;
+    tm->hard_ms = ctx->limits.max_time_ms > 0 ? ctx->limits.max_time_ms : default_time_ms;
+    tm->base_soft_ms = tm->hard_ms * TIME_SOFT_PERCENT / 100;
+}
+
+static void add_to_bank(TimeManager *tm, long saved_ms) {
+    tm->bank_ms += saved_ms;
+    if (tm->bank_ms < 0) tm->bank_ms = 0;
+    if (tm->bank_ms > tm->base_soft_ms * TIME_BANK_MAX_MOVES) tm->bank_ms = tm->base_soft_ms * TIME_BANK_MAX_MOVES;
+}
+
+void search_start(SearchContext *ctx, long default_time_ms, int root_moves) {
+    TimeManager *tm = &ctx->time;
+    set_budget(ctx, default_time_ms);
+    tm->soft_ms = tm->base_soft_ms + tm->bank_ms / TIME_BANK_SHARE;
+    if (tm->soft_ms > tm->hard_ms) tm->soft_ms = tm->hard_ms;
+    tm->root_moves = root_moves;
+    tm->last_best = MOVE_NONE;
+    tm->instability = 0;
+
+    tt_new_search(&ctx->tt);
+    ctx->time_exceeded = 0;
+
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    for (int d = 0; d <= MAX_DEPTH; d++) ctx->stats.depth_time_ms[d] = -1;
+    ctx->stats.threads = 1;
+
+    // La réflexion anticipée n'a pas de minuteur avant search_ponderhit ;
+    // le mode déterministe ne regarde jamais l'horloge
+    pthread_mutex_lock(&tm->lock);
+    clock_gettime(CLOCK_MONOTONIC, &ctx->start_time);
+    tm->origin_ms = 0;
+    tm->last_iter_end_ms = 0;
+    tm->last_iter_ms = 0;
+    tm->searching = 1;
+    atomic_store(&ctx->stop, tm->abort);
+    if (!ctx->limits.deterministic && !tm->pondering) start_timer(ctx);
+    pthread_mutex_unlock(&tm->lock);
+}
+
+int search_continue(SearchContext *ctx, const Move *best, int best_score) {
+    TimeManager *tm = &ctx->time;
+
+    // Rien à chercher : coup forcé ou fin de partie prouvée
+    if (tm->root_moves <= 1) return 0;
+    if (best_score >= SEARCH_WIN_SCORE || best_score <= -SEARCH_WIN_SCORE) return 0;
+
+    // Meilleur coup instable : prolonger de 50 % par niveau, deux niveaux au plus,
+    // qui retombent d'un cran à chaque itération où il ne change pas
+    uint8_t packed = pack_move(best);
+    if (tm->last_best != MOVE_NONE && packed != tm->last_best) tm->instability = 2;
+    else if (tm->instability > 0) tm->instability--;
+    tm->last_best = packed;
+
+    if (ctx->limits.deterministic) return 1;
+
+    pthread_mutex_lock(&tm->lock);
+    long elapsed = search_elapsed_ms(ctx);
+    long iter = elapsed - tm->last_iter_end_ms;
+    long growth = tm->last_iter_ms > 0 ? (iter + tm->last_iter_ms - 1) / tm->last_iter_ms : TIME_MIN_GROWTH;
+    if (growth < TIME_MIN_GROWTH) growth = TIME_MIN_GROWTH;
+    if (growth > TIME_MAX_GROWTH) growth = TIME_MAX_GROWTH;
+    tm->last_iter_end_ms = elapsed;
+    tm->last_iter_ms = iter;
+
+    int go = 1;   // En réflexion anticipée, pas de limite avant que l'adversaire ait joué
+    if (!tm->pondering) {
+        long now = elapsed - tm->origin_ms;
+        long soft = tm->soft_ms * (2 + tm->instability) / 2;
+        if (soft > tm->hard_ms) soft = tm->hard_ms;
+
+        // Une itération coupée par le minuteur est perdue : ne pas la commencer
+        // si elle doit durer plus que le temps restant
+        go = now < soft && now + iter * growth < tm->hard_ms;
+    }
+    pthread_mutex_unlock(&tm->lock);
+    return go;
+}
+
+void search_finish(SearchContext *ctx) {
+    TimeManager *tm = &ctx->time;
+
+    pthread_mutex_lock(&tm->lock);
+    int had_timer = tm->timer_running;
+    int counted = !tm->pondering && !tm->abort && !ctx->limits.deterministic;
+    tm->timer_running = 0;
+    tm->searching = 0;
+    tm->pondering = 0;
+    tm->abort = 0;
+    pthread_cond_signal(&tm->wake);
+    pthread_mutex_unlock(&tm->lock);
+    if (had_timer) pthread_join(tm->timer, NULL);
+
+    // Temps du coup : depuis search_ponderhit si la recherche a commencé en avance
+    ctx->stats.elapsed_ms = search_elapsed_ms(ctx) - tm->origin_ms;
+
+    // Banque : ce qui reste de la limite souple de base s'ajoute, le dépassement se retire
+    if (counted) add_to_bank(tm, tm->base_soft_ms - ctx->stats.elapsed_ms);
+}
+
+void search_bank_move(SearchContext *ctx, long default_time_ms) {
+    if (ctx->limits.deterministic) return;
+    set_budget(ctx, default_time_ms);
+    add_to_bank(&ctx->time, ctx->time.base_soft_ms);
+}
+
+/* ==== RÉFLEXION ANTICIPÉE ==== */
+
+void search_ponder(SearchContext *ctx) {
+    pthread_mutex_lock(&ctx->time.lock);
+    ctx->time.pondering = 1;
+    ctx->time.abort = 0;
+    pthread_mutex_unlock(&ctx->time.lock);
+}
+
+void search_ponderhit(SearchContext *ctx) {
+    TimeManager *tm = &ctx->time;
+    pthread_mutex_lock(&tm->lock);
+    if (tm->pondering) {
+        tm->pondering = 0;
+        // Déjà lancée : l'horloge du coup part de maintenant, la profondeur atteinte est gardée.
+        // Pas encore lancée : search_start démarrera une recherche normale
+        if (tm->searching) {
+            tm->origin_ms = search_elapsed_ms(ctx);
+            if (!ctx->limits.deterministic) start_timer(ctx);
+        }
+    }
+    pthread_mutex_unlock(&tm->lock);
+}
+
+void search_abort(SearchContext *ctx) {
+    TimeManager *tm = &ctx->time;
+    pthread_mutex_lock(&tm->lock);
+    if (tm->pondering) {
+        tm->abort = 1;
+        atomic_store(&ctx->stop, 1);
+    }
+    pthread_mutex_unlock(&tm->lock);
+}
+
+// Temps réel et non clock() : clock() additionne le CPU de tous les threads
+long search_elapsed_ms(const SearchContext *ctx) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - ctx->start_time.tv_sec) * 1000L
+         + (now.tv_nsec - ctx->start_time.tv_nsec) / 1000000L;
+}
+
+/* ==== ENFANTS D'UN NŒUD ==== */
+
+#define CHILD_SCORE_TT_MOVE 1000000
+#define CHILD_SCORE_KILLER 500000
+#define CHILD_SCORE_CAPTURE 1000
+
+int generate_children(const GameState *state, ChildList *list) {
+    Move moves[MAX_LEGAL_MOVES];
+    int n = generate_legal_moves(state, moves);
+
+    for (int i = 0; i < n; i++) {
+        SearchChild *c = &list->child[i];
+        c->state = *state;
+        c->move = moves[i];
+        c->captured = make_move(&c->state, &moves[i], NULL);
+        c->score = 0;
+        list->order[i] = (uint8_t)i;
+    }
+    list->count = n;
+    list->next = 0;
+    return n;
+}
+
+void score_children(ChildList *list, const Move (*killers)[2], int ply, const Move *tt_move, int depth) {
+    int net_gain = depth >= NET_GAIN_MIN_DEPTH;
+    for (int i = 0; i < list->count; i++) {
+        SearchChild *c = &list->child[i];
+        if (tt_move && same_move(tt_move, &c->move)) c->score = CHILD_SCORE_TT_MOVE;
+        else if (ply < MAX_DEPTH && (same_move(&killers[ply][0], &c->move) || same_move(&killers[ply][1], &c->move)))
+            c->score = CHILD_SCORE_KILLER;
+        else {
+            // Gain net : moins la meilleure capture que l'adversaire aura en réponse
+            int reply = net_gain ? best_capture(&c->state, c->state.current_player) : 0;
+            c->score = (c->captured - reply) * CHILD_SCORE_CAPTURE;
+        }
+    }
+}
+
+// Un pas de tri par sélection : le meilleur restant passe en tête
+SearchChild *next_child(ChildList *list) {
+    int i = list->next;
+    if (i >= list->count) return NULL;
+
+    int best = i;
+    for (int j = i + 1; j < list->count; j++) {
+        if (list->child[list->order[j]].score > list->child[list->order[best]].score) best = j;
+    }
+    uint8_t tmp = list->order[i];
+    list->order[i] = list->order[best];
+    list->order[best] = tmp;
+    list->next++;
+    return &list->child[list->order[i]];
+}
+
+/* ==== SÉLECTION ÉTAGÉE DES COUPS ==== */
+
+void picker_init(MovePicker *picker, const GameState *state, const Move *tt_move,
+                 const Move *killers, const int (*history)[NUM_COLORS]) {
+    picker->state = state;
+    picker->stage = PICK_TT_MOVE;
+    picker->tt_move = (tt_move && is_valid_move(state, tt_move)) ? pack_move(tt_move) : MOVE_NONE;
+    picker->killers[0] = picker->killers[1] = MOVE_NONE;
+    picker->killer_index = killers ? 0 : 2;
+    if (killers) {
+        picker->killer_moves[0] = killers[0];
+        picker->killer_moves[1] = killers[1];
+    }
+    picker->history = history;
+}
+
+static int picker_play(const MovePicker *picker, const Move *move, SearchChild *child) {
+    child->state = *picker->state;
+    child->move = *move;
+    child->captured = make_move(&child->state, move, NULL);
+    return 1;
+}
+
+static int picker_served(const MovePicker *picker, uint8_t packed) {
+    return packed == picker->tt_move || packed == picker->killers[0] || packed == picker->killers[1];
+}
+
+// Coups non encore servis : captures puis calmes, avec leurs clés de tri
+static void picker_generate(MovePicker *picker) {
+    Move moves[MAX_LEGAL_MOVES];
+    uint8_t captures[MAX_LEGAL_MOVES];
+    int n = move_captures(picker->state, picker->state->current_player, moves, captures);
+
+    int count = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) picker->capture_end = count;
+        for (int i = 0; i < n; i++) {
+            if ((captures[i] > 0) != (pass == 0) || picker_served(picker, pack_move(&moves[i]))) continue;
+            picker->moves[count] = moves[i];
+            if (pass == 0) picker->scores[count] = captures[i];
+            else picker->scores[count] = picker->history
+                ? picker->history[moves[i].hole_number - 1][moves[i].color] : 0;
+            count++;
+        }
+    }
+    picker->count = count;
+    picker->next = 0;
+}
+
+// Meilleur coup restant de [next, end) amené en next (un pas de tri par sélection)
+static const Move *picker_select(MovePicker *picker, int end) {
+    int i = picker->next;
+    if (i >= end) return NULL;
+
+    int best = i;
+    for (int j = i + 1; j < end; j++) {
+        if (picker->scores[j] > picker->scores[best]) best = j;
+    }
+    Move move = picker->moves[best];
+    int score = picker->scores[best];
+    picker->moves[best] = picker->moves[i];
+    picker->scores[best] = picker->scores[i];
+    picker->moves[i] = move;
+    picker->scores[i] = score;
+    picker->next++;
+    return &picker->moves[i];
+}
+
+int picker_next(MovePicker *picker, SearchChild *child) {
+    const Move *move;
+    switch (picker->stage) {
+    case PICK_TT_MOVE:
+        picker->stage = PICK_KILLERS;
+        if (picker->tt_move != MOVE_NONE) {
+            Move tt = unpack_move(picker->tt_move);
+            return picker_play(picker, &tt, child);
+        }
+        /* fallthrough */
+    case PICK_KILLERS:
+        while (picker->killer_index < 2) {
+            const Move *killer = &picker->killer_moves[picker->killer_index];
+            int k = picker->killer_index++;
+            if (!is_valid_move(picker->state, killer) || picker_served(picker, pack_move(killer))) continue;
+            picker->killers[k] = pack_move(killer);
+            return picker_play(picker, killer, child);
+        }
+        picker->stage = PICK_GENERATE;
+        /* fallthrough */
+    case PICK_GENERATE:
+        picker_generate(picker);
+        picker->stage = PICK_CAPTURES;
+        /* fallthrough */
+    case PICK_CAPTURES:
+        if ((move = picker_select(picker, picker->capture_end))) return picker_play(picker, move, child);
+        picker->stage = PICK_QUIET;
+        /* fallthrough */
+    case PICK_QUIET:
+        if ((move = picker_select(picker, picker->count))) return picker_play(picker, move, child);
+        picker->stage = PICK_DONE;
+        /* fallthrough */
+    case PICK_DONE:
+        break;
+    }
+    return 0;
+}
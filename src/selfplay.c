@@ -0,0 +1,188 @@
+//
+// selfplay.c - Lecture (mmap) et écriture en flux des positions de self-play
+//
+#include "../include/selfplay.h"
+#include "../include/mapfile.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define WRITER_BUFFER_SIZE (1 << 20)
+
+/* ==== CONVERSIONS ==== */
+
+void selfplay_pack(const GameState *state, SelfplayRecord *record) {
+    memset(record, 0, sizeof(*record));
+    memcpy(record->seeds, state->seeds, sizeof(record->seeds));
+    record->captures[0] = state->captures[0];
+    record->captures[1] = state->captures[1];
+    record->side = state->current_player;
+    record->turn_number = state->turn_number;
+    record->move = MOVE_NONE;
+}
+
+void selfplay_unpack(const SelfplayRecord *record, GameState *state) {
+    memset(state, 0, sizeof(*state));
+    memcpy(state->seeds, record->seeds, sizeof(state->seeds));
+    state->captures[0] = record->captures[0];
+    state->captures[1] = record->captures[1];
+    state->current_player = record->side;
+    state->turn_number = record->turn_number;
+    update_board_summary(state);
+    state->hash = compute_hash(state);
+}
+
+/* ==== LECTURE ==== */
+
+bool selfplay_open(SelfplayFile *file, const char *path) {
+    memset(file, 0, sizeof(*file));
+
+    size_t size;
+    void *data = map_file(path, &size);
+    if (!data) return false;
+
+    const SelfplayHeader *h = data;
+    bool valid = size >= sizeof(SelfplayHeader)
+              && memcmp(h->magic, SELFPLAY_MAGIC, sizeof(h->magic)) == 0
+              && h->record_size == sizeof(SelfplayRecord)
+              && h->count <= (size - sizeof(SelfplayHeader)) / sizeof(SelfplayRecord)
+              && h->index_offset == sizeof(SelfplayHeader) + h->count * sizeof(SelfplayRecord)
+              && h->count <= (size - h->index_offset) / sizeof(SelfplayIndexEntry);
+    if (!valid) {
+        unmap_file(data, size);
+        return false;
+    }
+
+    file->data = data;
+    file->size = size;
+    file->records = (const SelfplayRecord *)(h + 1);
+    file->index = (const SelfplayIndexEntry *)((const char *)data + h->index_offset);
+    file->count = h->count;
+    return true;
+}
+
+void selfplay_close(SelfplayFile *file) {
+    unmap_file(file->data, file->size);
+    memset(file, 0, sizeof(*file));
+}
+
+const SelfplayRecord *selfplay_find(const SelfplayFile *file, uint64_t key) {
+    size_t lo = 0, hi = file->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint64_t k = file->index[mid].key;
+        if (k == key) return &file->records[file->index[mid].record];
+        if (k < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return NULL;
+}
+
+/* ==== ÉCRITURE ==== */
+
+// Table ouverte des clés écrites, agrandie à moitié pleine
+static bool writer_grow(SelfplayWriter *w) {
+    size_t slots = w->mask ? 2 * (w->mask + 1) : 1 << 16;
+    uint64_t *grown = calloc(slots, sizeof(uint64_t));
+    if (!grown) return false;
+
+    for (size_t i = 0; i < w->count; i++) {
+        uint64_t key = w->index[i].key;
+        size_t s = key & (slots - 1);
+        while (grown[s] != 0) s = (s + 1) & (slots - 1);
+        grown[s] = key;
+    }
+    free(w->slots);
+    w->slots = grown;
+    w->mask = slots - 1;
+    return true;
+}
+
+// Emplacement de key dans la table : la clé elle-même ou un slot vide
+static uint64_t *writer_slot(const SelfplayWriter *w, uint64_t key) {
+    size_t s = key & w->mask;
+    while (w->slots[s] != 0 && w->slots[s] != key) s = (s + 1) & w->mask;
+    return &w->slots[s];
+}
+
+bool selfplay_writer_open(SelfplayWriter *w, const char *path) {
+    memset(w, 0, sizeof(*w));
+    snprintf(w->path, sizeof(w->path), "%s", path);
+
+    char tmp[1040];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    w->file = fopen(tmp, "wb");
+    if (!w->file || !writer_grow(w)) return false;
+    setvbuf(w->file, NULL, _IOFBF, WRITER_BUFFER_SIZE);
+
+    // En-tête provisoire, réécrit à la fermeture
+    SelfplayHeader h = {0};
+    if (fwrite(&h, sizeof(h), 1, w->file) != 1) return false;
+
+    // Positions d'un fichier existant, dans leur ordre d'origine
+    SelfplayFile previous;
+    if (selfplay_open(&previous, path)) {
+        uint64_t *keys = malloc(previous.count * sizeof(uint64_t) + 1);
+        if (keys) {
+            for (size_t i = 0; i < previous.count; i++) keys[previous.index[i].record] = previous.index[i].key;
+            for (size_t i = 0; i < previous.count; i++) selfplay_writer_add(w, keys[i], &previous.records[i]);
+            free(keys);
+        }
+        selfplay_close(&previous);
+    }
+    return true;
+}
+
+bool selfplay_writer_add(SelfplayWriter *w, uint64_t key, const SelfplayRecord *record) {
+    uint64_t *slot = writer_slot(w, key);
+    if (*slot == key) return false;
+
+    if (w->count == w->cap) {
+        size_t cap = w->cap ? w->cap * 2 : 4096;
+        SelfplayIndexEntry *grown = realloc(w->index, cap * sizeof(SelfplayIndexEntry));
+        if (!grown) return false;
+        w->index = grown;
+        w->cap = cap;
+    }
+    if (fwrite(record, sizeof(*record), 1, w->file) != 1) return false;
+
+    *slot = key;
+    w->index[w->count] = (SelfplayIndexEntry){ key, w->count };
+    w->count++;
+    if (2 * w->count > w->mask + 1) writer_grow(w);
+    return true;
+}
+
+static int compare_index(const void *a, const void *b) {
+    uint64_t x = ((const SelfplayIndexEntry *)a)->key, y = ((const SelfplayIndexEntry *)b)->key;
+    return (x > y) - (x < y);
+}
+
+bool selfplay_writer_close(SelfplayWriter *w) {
+    char tmp[1040];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", w->path);
+    bool ok = w->file != NULL;
+
+    if (ok) {
+        if (w->count > 0) qsort(w->index, w->count, sizeof(SelfplayIndexEntry), compare_index);
+        SelfplayHeader h = {
+            .record_size = sizeof(SelfplayRecord),
+            .count = w->count,
+            .index_offset = sizeof(SelfplayHeader) + w->count * sizeof(SelfplayRecord),
+        };
+        memcpy(h.magic, SELFPLAY_MAGIC, sizeof(h.magic));
+
+        ok = fwrite(w->index, sizeof(SelfplayIndexEntry), w->count, w->file) == w->count
+          && fseek(w->file, 0, SEEK_SET) == 0
+          && fwrite(&h, sizeof(h), 1, w->file) == 1;
+        ok = (fclose(w->file) == 0) && ok;
+    }
+
+    if (!ok || rename(tmp, w->path) != 0) {
+        remove(tmp);
+        ok = false;
+    }
+    free(w->index);
+    free(w->slots);
+    memset(w, 0, sizeof(*w));
+    return ok;
+}
@@ -0,0 +1,108 @@
+//
+// sprt.c - SPRT pentanomial (approximation normale du LLR généralisé)
+//
+#include "../include/sprt.h"
+#include <math.h>
+#include <string.h>
+
+/* ==== OUTILS ==== */
+
+// Score attendu d'une partie pour un écart d'Elo donné
+static double elo_to_score(double elo) {
+    return 1.0 / (1.0 + pow(10.0, -elo / 400.0));
+}
+
+static double score_to_elo(double score) {
+    if (score <= 0.0) score = 1e-6;
+    if (score >= 1.0) score = 1.0 - 1e-6;
+    return -400.0 * log10(1.0 / score - 1.0);
+}
+
+// Moyenne et variance du score normalisé d'une paire (0, 0.25, ..., 1)
+static int pair_moments(const Sprt *sprt, double *mean, double *variance) {
+    int n = sprt_pairs(sprt);
+    if (n == 0) return 0;
+
+    double m = 0.0;
+    for (int k = 0; k < 5; k++) m += sprt->penta[k] * (k / 4.0);
+    m /= n;
+
+    double v = 0.0;
+    for (int k = 0; k < 5; k++) {
+        double d = k / 4.0 - m;
+        v += sprt->penta[k] * d * d;
+    }
+    v /= n;
+
+    *mean = m;
+    *variance = v;
+    return n;
+}
+
+/* ==== API ==== */
+
+void sprt_init(Sprt *sprt, double elo0, double elo1, double alpha, double beta) {
+    memset(sprt, 0, sizeof(*sprt));
+    sprt->elo0 = elo0;
+    sprt->elo1 = elo1;
+    sprt->alpha = alpha;
+    sprt->beta = beta;
+}
+
+void sprt_add_pair(Sprt *sprt, double score1, double score2) {
+    double scores[2] = { score1, score2 };
+    for (int i = 0; i < 2; i++) {
+        if (scores[i] >= 1.0) sprt->wins++;
+        else if (scores[i] <= 0.0) sprt->losses++;
+        else sprt->draws++;
+    }
+    int k = (int)lround((score1 + score2) * 2.0);
+    if (k < 0) k = 0;
+    if (k > 4) k = 4;
+    sprt->penta[k]++;
+}
+
+int sprt_pairs(const Sprt *sprt) {
+    int n = 0;
+    for (int k = 0; k < 5; k++) n += sprt->penta[k];
+    return n;
+}
+
+// LLR ~ N (s1 - s0)(2m - s0 - s1) / (2 var) : test de la moyenne d'une loi
+// normale de variance estimée, appliqué aux scores des paires
+double sprt_llr(const Sprt *sprt) {
+    double mean, variance;
+    int n = pair_moments(sprt, &mean, &variance);
+    if (n == 0 || variance <= 0.0) return 0.0;
+
+    double s0 = elo_to_score(sprt->elo0);
+    double s1 = elo_to_score(sprt->elo1);
+    return n * (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * variance);
+}
+
+void sprt_bounds(const Sprt *sprt, double *lower, double *upper) {
+    *lower = log(sprt->beta / (1.0 - sprt->alpha));
+    *upper = log((1.0 - sprt->beta) / sprt->alpha);
+}
+
+int sprt_status(const Sprt *sprt) {
+    double lower, upper, llr = sprt_llr(sprt);
+    sprt_bounds(sprt, &lower, &upper);
+    if (llr >= upper) return SPRT_ACCEPT_H1;
+    if (llr <= lower) return SPRT_ACCEPT_H0;
+    return SPRT_CONTINUE;
+}
+
+void sprt_elo(const Sprt *sprt, double *elo, double *error95) {
+    double mean, variance;
+    int n = pair_moments(sprt, &mean, &variance);
+    if (n == 0) {
+        *elo = 0.0;
+        *error95 = 0.0;
+        return;
+    }
+
+    double margin = 1.96 * sqrt(variance / n);
+    *elo = score_to_elo(mean);
+    *error95 = (score_to_elo(mean + margin) - score_to_elo(mean - margin)) / 2.0;
+}
@@ -0,0 +1,112 @@
+//
+// tablebase.c - Lecture (mmap) et écriture de la table de finales
+//
+#include "../include/tablebase.h"
+#include "../include/mapfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==== LECTURE ==== */
+
+bool tb_open(Tablebase *tb, const char *path) {
+    memset(tb, 0, sizeof(*tb));
+
+    size_t size;
+    void *data = map_file(path, &size);
+    if (!data) return false;
+
+    const TablebaseHeader *h = data;
+    if (size < sizeof(TablebaseHeader) || memcmp(h->magic, TB_MAGIC, sizeof(h->magic)) != 0
+        || h->count > (size - sizeof(TablebaseHeader)) / (sizeof(uint64_t) + sizeof(int8_t))) {
+        unmap_file(data, size);
+        return false;
+    }
+
+    tb->data = data;
+    tb->size = size;
+    tb->keys = (const uint64_t *)(h + 1);
+    tb->margins = (const int8_t *)(tb->keys + h->count);
+    tb->count = h->count;
+    tb->max_seeds = (int)h->max_seeds;
+    tb->horizon = (int)h->horizon;
+    return true;
+}
+
+void tb_close(Tablebase *tb) {
+    unmap_file(tb->data, tb->size);
+    memset(tb, 0, sizeof(*tb));
+}
+
+bool tb_probe(const Tablebase *tb, const GameState *state, int *margin) {
+    if (state->summary.total > tb->max_seeds) return false;
+
+    uint64_t key = board_key(state);
+    size_t lo = 0, hi = tb->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint64_t k = tb->keys[mid];
+        if (k == key) {
+            *margin = tb->margins[mid];
+            return true;
+        }
+        if (k < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return false;
+}
+
+bool tb_probe_score(const Tablebase *tb, const GameState *state, PlayerIndex player, int *score) {
+    int margin;
+    // Demi-coups encore joués : tours turn_number..TB_LAST_TURN
+    if (TB_LAST_TURN + 1 - state->turn_number < tb->horizon || !tb_probe(tb, state, &margin)) return false;
+
+    PlayerIndex mover = state->current_player;
+    int final_diff = state->captures[mover] - state->captures[1 - mover] + margin;
+    int s = final_diff > 0 ? TB_WIN_SCORE + final_diff
+          : final_diff < 0 ? -TB_WIN_SCORE + final_diff : 0;
+    *score = (mover == player) ? s : -s;
+    return true;
+}
+
+/* ==== ÉCRITURE ==== */
+
+typedef struct {
+    uint64_t key;
+    int8_t margin;
+} TablebasePair;
+
+static int compare_pairs(const void *a, const void *b) {
+    uint64_t x = ((const TablebasePair *)a)->key, y = ((const TablebasePair *)b)->key;
+    return (x > y) - (x < y);
+}
+
+bool tb_write(const char *path, int max_seeds, int horizon, uint64_t *keys, int8_t *margins, size_t count) {
+    TablebasePair *pairs = malloc(count * sizeof(TablebasePair) + 1);
+    if (!pairs) return false;
+    for (size_t i = 0; i < count; i++) pairs[i] = (TablebasePair){ keys[i], margins[i] };
+    qsort(pairs, count, sizeof(TablebasePair), compare_pairs);
+    for (size_t i = 0; i < count; i++) {
+        keys[i] = pairs[i].key;
+        margins[i] = pairs[i].margin;
+    }
+    free(pairs);
+
+    char tmp[1024];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");
+    if (!f) return false;
+
+    TablebaseHeader h = { .max_seeds = (uint32_t)max_seeds, .horizon = (uint32_t)horizon, .count = count };
+    memcpy(h.magic, TB_MAGIC, sizeof(h.magic));
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+           && fwrite(keys, sizeof(uint64_t), count, f) == count
+           && fwrite(margins, sizeof(int8_t), count, f) == count;
+    ok = (fclose(f) == 0) && ok;
+
+    if (!ok || rename(tmp, path) != 0) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,134 @@
+//
+// tt.c - Table de transposition à buckets, remplacement par profondeur et âge
+//
+#include "../include/tt.h"
+#include <stdlib.h>
+#include <string.h>
+
+static size_t default_size_mb = TT_DEFAULT_SIZE_MB;
+
+/* ==== ENCODAGE DES SLOTS ==== */
+
+// Les accès passent par des atomiques relâchés : simples mov sur x86-64, mais
+// pas de data race au sens du C quand plusieurs threads partagent la table
+static inline uint64_t slot_load(const uint64_t *p) {
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+static inline void slot_write(uint64_t *p, uint64_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t pack_data(int score, int depth, int flag, uint8_t move, uint8_t generation) {
+    return (uint64_t)(uint32_t)score
+         | (uint64_t)(uint8_t)depth << 32
+         | (uint64_t)(uint8_t)flag << 40
+         | (uint64_t)move << 48
+         | (uint64_t)generation << 56;
+}
+
+static inline void unpack_data(uint64_t key, uint64_t data, TTEntry *out) {
+    out->key = key;
+    out->score = (int32_t)(uint32_t)data;
+    out->depth = (int8_t)(data >> 32);
+    out->flag = (uint8_t)(data >> 40);
+    out->move = (uint8_t)(data >> 48);
+    out->generation = (uint8_t)(data >> 56);
+}
+
+/* ==== GESTION DE LA TABLE ==== */
+
+int tt_init(TranspositionTable *tt, size_t size_mb) {
+    size_t bytes = size_mb * 1024 * 1024;
+    size_t count = 1;
+    while (count * 2 * sizeof(TTBucket) <= bytes) count *= 2;
+
+    tt->buckets = calloc(count, sizeof(TTBucket));
+    tt->mask = tt->buckets ? count - 1 : 0;
+    tt->generation = 0;
+    return tt->buckets != NULL;
+}
+
+void tt_free(TranspositionTable *tt) {
+    free(tt->buckets);
+    tt->buckets = NULL;
+    tt->mask = 0;
+}
+
+void tt_clear(TranspositionTable *tt) {
+    memset(tt->buckets, 0, (tt->mask + 1) * sizeof(TTBucket));
+    tt->generation = 0;
+}
+
+void tt_set_default_size_mb(size_t size_mb) {
+    default_size_mb = size_mb ? size_mb : 1;
+}
+
+size_t tt_default_size_mb(void) {
+    return default_size_mb;
+}
+
+void tt_new_search(TranspositionTable *tt) {
+    tt->generation++;
+}
+
+/* ==== PROBE / STORE ==== */
+
+bool tt_probe(const TranspositionTable *tt, uint64_t key, TTEntry *out) {
+    const TTBucket *bucket = &tt->buckets[key & tt->mask];
+    for (int i = 0; i < TT_BUCKET_ENTRIES; i++) {
+        uint64_t data = slot_load(&bucket->slots[i].data);
+        uint64_t check = slot_load(&bucket->slots[i].check);
+        if ((check ^ data) == key && (check | data)) {
+            unpack_data(key, data, out);
+            return true;
+        }
+    }
+    return false;
+}
+
+void tt_store(TranspositionTable *tt, uint64_t key, int depth, int score, int flag, const Move *best_move) {
+    TTBucket *bucket = &tt->buckets[key & tt->mask];
+    TTSlot *slot = &bucket->slots[0];
+    uint64_t slot_data = 0;
+    int slot_value = 1 << 30;
+    int same_key = 0;
+
+    for (int i = 0; i < TT_BUCKET_ENTRIES; i++) {
+        TTSlot *s = &bucket->slots[i];
+        uint64_t data = slot_load(&s->data);
+        uint64_t check = slot_load(&s->check);
+        TTEntry e;
+        unpack_data(check ^ data, data, &e);
+
+        // Même position : mise à jour en place, sauf si l'entrée de cette
+        // recherche est nettement plus profonde et non exacte
+        if (e.key == key && (check | data)) {
+            if (flag != TT_EXACT && e.generation == tt->generation && depth + 2 < e.depth) {
+                return;
+            }
+            slot = s;
+            slot_data = data;
+            same_key = 1;
+            break;
+        }
+
+        // Sinon on remplace l'entrée la moins utile : vide, ancienne ou peu profonde
+        int age = (uint8_t)(tt->generation - e.generation);
+        int value = (check | data) ? e.depth - 8 * age : -(1 << 30);
+        if (value < slot_value) {
+            slot = s;
+            slot_data = data;
+            slot_value = value;
+        }
+    }
+
+    uint8_t move = best_move ? pack_move(best_move) : MOVE_NONE;
+    if (move == MOVE_NONE && same_key) {
+        move = (uint8_t)(slot_data >> 48);
+    }
+
+    uint64_t data = pack_data(score, depth, flag, move, tt->generation);
+    slot_write(&slot->data, data);
+    slot_write(&slot->check, key ^ data);
+}